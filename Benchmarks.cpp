@@ -0,0 +1,191 @@
+//============================================================================
+// Name        : Benchmarks.cpp
+// Course      : CS 300 - DSA Design and Analysis
+// Description : Microbenchmarks for the advisor program's hot paths:
+//                 - load      (LoadCatalog: parse, insert, validate, index)
+//                 - search    (CourseBST::Search, hits and misses)
+//                 - list      (CourseBST::PrintInOrder, formatting every time)
+//                 - listing   (option 2: rendered once per load, then one write)
+//                 - course    (PrintCourse, option 3, uniform queries, no cache)
+//                 - cached    (option 3 through the hot course cache, skewed
+//                              queries: 90% go to 32 intro courses)
+//               over synthetic catalogs (SyntheticCatalog.h) in sorted,
+//               random and adversarial key order at several sizes.
+//               Reports throughput and p50 / p90 / p99 latency per operation.
+// Build       : g++ -std=c++17 -O2 -pthread Benchmarks.cpp -o benchmarks
+// Usage       : ./benchmarks [size ...]      (default 1000 10000 50000)
+// Notes       : -Self contained harness, no Google Benchmark dependency.
+//               -ProjectTwo.cpp is included directly (its menu and main are
+//                compiled out) so the benchmarks exercise the exact same code.
+//               -Printing goes to a null stream so terminal speed isn't measured.
+//               -Sorted and adversarial orders are the worst cases for an
+//                unbalanced tree; they stay in to show the index keeps its
+//                balance whatever order the file is in.
+//============================================================================
+
+#define ABCU_NO_MAIN
+#include "ProjectTwo.cpp"
+#include "SyntheticCatalog.h"
+
+#include <chrono>
+#include <cstdio>
+#include <iomanip>
+#include <random>
+
+using Clock = chrono::steady_clock;
+
+// ------------------------------ Synthetic Data -------------------------------
+
+// Sorted, random, and zig-zag with long shared-prefix keys (adversarial).
+static GeneratorOptions BenchOptions(size_t n, KeyOrder order) {
+    GeneratorOptions options;
+    options.courses = n;
+    options.seed = n * 31 + static_cast<uint64_t>(order);
+    options.order = order;
+    // Long keys don't fit a -DABCU_FIXED_COURSE_CODES build.
+    options.longKeys = order == KeyOrder::ZigZag && CourseKey::MaxLength >= 16;
+    return options;
+}
+
+static const char* OrderName(KeyOrder order) {
+    switch (order) {
+        case KeyOrder::Sorted: return "sorted";
+        case KeyOrder::Random: return "random";
+        default:               return "adversarial";
+    }
+}
+
+// -------------------------------- Measuring ----------------------------------
+
+// Swallows output so printing is measured without the terminal.
+class NullBuffer : public streambuf {
+protected:
+    int overflow(int ch) override { return ch; }
+    streamsize xsputn(const char*, streamsize n) override { return n; }
+};
+
+struct Result {
+    string name;
+    string order;
+    size_t n;
+    vector<double> samples; // nanoseconds per operation
+};
+
+static double Percentile(vector<double>& sorted, double p) {
+    if (sorted.empty()) return 0;
+    size_t i = static_cast<size_t>(p * (sorted.size() - 1) + 0.5);
+    return sorted[i];
+}
+
+static void Report(Result r) {
+    sort(r.samples.begin(), r.samples.end());
+    double total = 0;
+    for (double s : r.samples) total += s;
+    double opsPerSec = total > 0 ? r.samples.size() * 1e9 / total : 0;
+    cout << left << setw(8) << r.name << setw(13) << r.order << right << setw(9) << r.n
+         << fixed << setprecision(0) << setw(14) << opsPerSec
+         << setw(13) << Percentile(r.samples, 0.50)
+         << setw(13) << Percentile(r.samples, 0.90)
+         << setw(13) << Percentile(r.samples, 0.99) << '\n';
+}
+
+template <typename Op>
+static double TimeNs(Op op) {
+    Clock::time_point start = Clock::now();
+    op();
+    return chrono::duration<double, nano>(Clock::now() - start).count();
+}
+
+// ---------------------------------- Runs -------------------------------------
+
+static void RunSize(size_t n, KeyOrder order, const string& scratchPath) {
+    const GeneratorOptions options = BenchOptions(n, order);
+    mt19937 rng(static_cast<uint32_t>(options.seed));
+    {
+        ofstream out(scratchPath, ios::binary);
+        WriteSyntheticCatalog(out, options);
+    }
+
+    // Load: whole loads, a few repetitions.
+    Result load{"load", OrderName(order), n, {}};
+    Catalog catalog;
+    vector<string> errors;
+    size_t count = 0;
+    const int loadRuns = 5;
+    for (int i = 0; i < loadRuns; ++i) {
+        load.samples.push_back(TimeNs([&] { LoadCatalog(scratchPath, catalog, errors, count); }));
+    }
+    Report(load);
+
+    // Search: per lookup, half hits and half misses, in random order.
+    const size_t lookups = 20000;
+    vector<CourseKey> keys;
+    keys.reserve(lookups);
+    for (size_t i = 0; i < lookups; ++i) {
+        size_t id = rng() % n;
+        if (i % 2) id += n; // never in the catalog
+        string number = SyntheticCourseNumber(id, options);
+        CourseKey key;
+        CourseKey::FromString(number, key);
+        keys.push_back(key);
+    }
+    Result search{"search", OrderName(order), n, {}};
+    search.samples.reserve(lookups);
+    volatile int sink = 0;
+    for (const CourseKey& key : keys) {
+        search.samples.push_back(TimeNs([&] { sink = sink + catalog.bst.Search(key); }));
+    }
+    Report(search);
+
+    NullBuffer nullBuffer;
+    streambuf* saved = cout.rdbuf(&nullBuffer);
+
+    Result list{"list", OrderName(order), n, {}};
+    for (int i = 0; i < 10; ++i) {
+        list.samples.push_back(TimeNs([&] { catalog.bst.PrintInOrder(); cout.flush(); }));
+    }
+
+    Result listing{"listing", OrderName(order), n, {}};
+    for (int i = 0; i < 10; ++i) {
+        listing.samples.push_back(TimeNs([&] { PrintCourseList(catalog); cout.flush(); }));
+    }
+
+    Result course{"course", OrderName(order), n, {}};
+    const size_t prints = 5000;
+    for (size_t i = 0; i < prints; ++i) {
+        string number = SyntheticCourseNumber(rng() % n, options);
+        course.samples.push_back(TimeNs([&] { PrintCourse(cout, catalog.bst, catalog.fuzzy, number); }));
+    }
+
+    Result cached{"cached", OrderName(order), n, {}};
+    const size_t hot = min<size_t>(32, n);
+    for (size_t i = 0; i < prints; ++i) {
+        size_t id = (rng() % 10 != 0) ? rng() % hot : rng() % n;
+        string number = SyntheticCourseNumber(id, options);
+        cached.samples.push_back(TimeNs([&] { PrintCourse(catalog, number); }));
+    }
+
+    cout.rdbuf(saved);
+    Report(list);
+    Report(listing);
+    Report(course);
+    Report(cached);
+}
+
+int main(int argc, char* argv[]) {
+    vector<size_t> sizes;
+    for (int i = 1; i < argc; ++i) sizes.push_back(static_cast<size_t>(stoull(argv[i])));
+    if (sizes.empty()) sizes = {1000, 10000, 50000};
+
+    const string scratchPath = (filesystem::temp_directory_path() / "abcu_bench_catalog.csv").string();
+
+    cout << left << setw(8) << "bench" << setw(13) << "order" << right << setw(9) << "n"
+         << setw(14) << "ops/s" << setw(13) << "p50 ns" << setw(13) << "p90 ns" << setw(13) << "p99 ns" << '\n';
+    for (size_t n : sizes) {
+        for (KeyOrder order : {KeyOrder::Sorted, KeyOrder::Random, KeyOrder::ZigZag}) {
+            RunSize(n, order, scratchPath);
+        }
+    }
+    filesystem::remove(scratchPath);
+    return 0;
+}
@@ -0,0 +1,193 @@
+//============================================================================
+// Name        : CsvCheck.cpp
+// Course      : CS 300 - DSA Design and Analysis
+// Description : Self check for CsvReader (ProjectTwo.cpp). Parses random
+//               CSV text with tiny block sizes (1 to 8 bytes, so records
+//               straddle every possible refill) and checks every result
+//               matches the normal 64 KiB block. Lines with no field that
+//               starts with a quote must also split exactly like splitCSV,
+//               and a few hand written cases pin down known edge cases.
+// Build       : g++ -std=c++17 -g -fsanitize=address,undefined -pthread CsvCheck.cpp -o csv_check
+// Usage       : ./csv_check [rounds]      (default 2000; exit status 1 on a mismatch)
+// Notes       : -Same approach as Benchmarks.cpp: ProjectTwo.cpp is included
+//                directly (its menu and main are compiled out).
+//               -Run it under the sanitizers; the point is as much the buffer
+//                handling across refills as the field values.
+//============================================================================
+
+#define ABCU_NO_MAIN
+#include "ProjectTwo.cpp"
+
+#include <random>
+#include <sstream>
+
+// ------------------------------- Parsing -------------------------------------
+
+struct ParsedRecord {
+    vector<string> fields;
+    size_t line = 0;
+    bool unterminated = false;
+
+    bool operator==(const ParsedRecord& other) const {
+        return fields == other.fields && line == other.line && unterminated == other.unterminated;
+    }
+};
+
+static vector<ParsedRecord> ParseAll(const string& text, size_t blockSize) {
+    istringstream stream(text);
+    StreamSource source(stream);
+    CsvReader reader(source, blockSize);
+    vector<ParsedRecord> records;
+    vector<string_view> fields;
+    while (reader.Next(fields)) {
+        ParsedRecord r;
+        r.fields.assign(fields.begin(), fields.end());
+        r.line = reader.RecordLine();
+        r.unterminated = reader.Unterminated();
+        records.push_back(move(r));
+    }
+    return records;
+}
+
+// Escaped so CR, LF and quotes are visible in a failure report.
+static string Shown(const string& text) {
+    string out;
+    for (char ch : text) {
+        if (ch == '\n') out += "\\n";
+        else if (ch == '\r') out += "\\r";
+        else out += ch;
+    }
+    return out;
+}
+
+static void PrintRecords(const vector<ParsedRecord>& records) {
+    for (const ParsedRecord& r : records) {
+        cerr << "    line " << r.line << (r.unterminated ? " (unterminated)" : "") << ":";
+        for (const string& f : r.fields) cerr << " [" << Shown(f) << "]";
+        cerr << '\n';
+    }
+}
+
+static bool Report(const char* what, const string& text, const vector<ParsedRecord>& expected,
+                   const vector<ParsedRecord>& got) {
+    if (expected == got) return true;
+    cerr << "FAIL " << what << "\n  input: " << Shown(text) << "\n  expected:\n";
+    PrintRecords(expected);
+    cerr << "  got:\n";
+    PrintRecords(got);
+    return false;
+}
+
+// ------------------------------ Random Input ---------------------------------
+
+// One field, picked to hit the reader's edge cases: quotes mid field, quoted
+// commas and newlines, "" escapes, blanks around quotes, empty fields.
+static string RandomField(mt19937& rng, bool allowQuoted) {
+    static const char* const plain[] = {
+        "CSCI100", "Intro", "5\" Floppy Disks", "a\"b\"c", "x\"", "  padded  ", "", "\t", "MATH201"
+    };
+    static const char* const quoted[] = {
+        "\"Data Structures, Part II\"", "\"two\nlines\"", "\"say \"\"hi\"\"\"", "\"\"",
+        "  \"blank before\"", "\"junk after\"xyz", "\"crlf\r\ninside\"", "\"a\"\"\""
+    };
+    const size_t plainCount = sizeof(plain) / sizeof(plain[0]);
+    const size_t quotedCount = sizeof(quoted) / sizeof(quoted[0]);
+    if (allowQuoted && rng() % 3 == 0) return quoted[rng() % quotedCount];
+    return plain[rng() % plainCount];
+}
+
+static string RandomLine(mt19937& rng, bool allowQuoted) {
+    string line;
+    const size_t fields = 1 + rng() % 5;
+    for (size_t i = 0; i < fields; ++i) {
+        if (i) line += ',';
+        line += RandomField(rng, allowQuoted);
+    }
+    return line;
+}
+
+static string RandomText(mt19937& rng, bool allowQuoted, vector<string>* lines = nullptr) {
+    string text;
+    if (rng() % 10 == 0 && !lines) text += "\xEF\xBB\xBF";
+    const size_t count = 1 + rng() % 12;
+    for (size_t i = 0; i < count; ++i) {
+        string line = RandomLine(rng, allowQuoted);
+        if (lines) lines->push_back(line);
+        text += line;
+        // Mostly LF, some CRLF, and sometimes no newline after the last line
+        // (unless it's empty: then there'd be no line at all).
+        if (i + 1 < count || line.empty() || rng() % 4) text += rng() % 3 ? "\n" : "\r\n";
+    }
+    // Now and then leave a quoted field open at end of input.
+    if (allowQuoted && rng() % 8 == 0) text += "CSCI999,\"never closed";
+    return text;
+}
+
+// What splitCSV makes of each line, numbered like the reader numbers them.
+static vector<ParsedRecord> SplitEachLine(const vector<string>& lines) {
+    vector<ParsedRecord> records;
+    vector<string_view> fields;
+    for (size_t i = 0; i < lines.size(); ++i) {
+        splitCSV(lines[i], fields);
+        ParsedRecord r;
+        r.fields.assign(fields.begin(), fields.end());
+        r.line = i + 1;
+        records.push_back(move(r));
+    }
+    return records;
+}
+
+// ------------------------------- Checks --------------------------------------
+
+static bool CheckKnownCases() {
+    bool ok = true;
+    auto record = [](size_t line, vector<string> fields, bool unterminated = false) {
+        ParsedRecord r;
+        r.fields = move(fields);
+        r.line = line;
+        r.unterminated = unterminated;
+        return r;
+    };
+
+    // A quote inside a plain field is text, and must not swallow the lines after it.
+    string text = "CSCI103,5\" Floppy Disks\nCSCI104,Plain\nCSCI105,\"Quoted, title\",CSCI104\n";
+    ok &= Report("mid field quote", text,
+                 {record(1, {"CSCI103", "5\" Floppy Disks"}), record(2, {"CSCI104", "Plain"}),
+                  record(3, {"CSCI105", "Quoted, title", "CSCI104"})},
+                 ParseAll(text, 1 << 16));
+
+    text = "A,\"multi\nline\",\"say \"\"hi\"\"\"\nB,x\n";
+    ok &= Report("quoted newline and escapes", text,
+                 {record(1, {"A", "multi\nline", "say \"hi\""}), record(3, {"B", "x"})},
+                 ParseAll(text, 1 << 16));
+
+    text = "A,\"open\nB,x\n";
+    ok &= Report("unterminated quote", text, {record(1, {"A", "open\nB,x\n"}, true)}, ParseAll(text, 1 << 16));
+    return ok;
+}
+
+static bool CheckRandom(size_t rounds) {
+    mt19937 rng(12345);
+    for (size_t round = 0; round < rounds; ++round) {
+        const string text = RandomText(rng, true);
+        const vector<ParsedRecord> expected = ParseAll(text, 1 << 16);
+        for (size_t block = 1; block <= 8; ++block) {
+            if (!Report(("block size " + to_string(block)).c_str(), text, expected, ParseAll(text, block))) return false;
+        }
+
+        vector<string> lines;
+        const string plainText = RandomText(rng, false, &lines);
+        const vector<ParsedRecord> split = SplitEachLine(lines);
+        for (size_t block : {size_t(1), size_t(3), size_t(1) << 16}) {
+            if (!Report("plain lines vs splitCSV", plainText, split, ParseAll(plainText, block))) return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    const size_t rounds = argc > 1 ? strtoul(argv[1], nullptr, 10) : 2000;
+    const bool ok = CheckKnownCases() && CheckRandom(rounds);
+    cout << (ok ? "ok" : "FAILED") << '\n';
+    return ok ? 0 : 1;
+}
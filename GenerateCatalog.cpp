@@ -0,0 +1,169 @@
+//============================================================================
+// Name        : GenerateCatalog.cpp
+// Course      : CS 300 - DSA Design and Analysis
+// Description : Writes a synthetic course catalog CSV for scale testing
+//               ProjectTwo and Benchmarks (see SyntheticCatalog.h).
+// Build       : g++ -std=c++17 -O2 GenerateCatalog.cpp -o generate_catalog
+// Usage       : ./generate_catalog [options] [-o file]     (stdout by default)
+//                 --courses N         number of courses            (1000)
+//                 --seed S            random seed                  (1)
+//                 --order O           sorted | random | zigzag     (random)
+//                 --sortedness F      0..1, share of rows left sorted (0)
+//                 --long-keys         16 byte numbers, shared prefix
+//                 --mean-prereqs F    average prerequisites        (1.5)
+//                 --max-prereqs N     prerequisite cap             (6)
+//                 --skew F            fan-in skew, 1 = uniform     (2)
+//                 --title-words A B   title length range in words  (2 6)
+//                 --quoted-rate F     titles with a quoted comma   (0)
+//                 --duplicate-rate F  repeated course numbers      (0)
+//                 --missing-rate F    prerequisites not in catalog (0)
+//                 --malformed-rate F  lines the loader must skip   (0)
+//                 --error-rate F      sets all three error rates at once
+// Example     : ./generate_catalog --courses 2000000 --error-rate 0.001 -o big.csv
+//               A summary of what was written goes to stderr.
+//============================================================================
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "SyntheticCatalog.h"
+
+using namespace std;
+
+static void PrintUsage() {
+    cerr << "Usage: generate_catalog [--courses N] [--seed S] [--order sorted|random|zigzag]\n"
+         << "                        [--sortedness F] [--long-keys] [--mean-prereqs F]\n"
+         << "                        [--max-prereqs N] [--skew F] [--title-words MIN MAX]\n"
+         << "                        [--quoted-rate F] [--duplicate-rate F] [--missing-rate F]\n"
+         << "                        [--malformed-rate F] [--error-rate F] [-o file]\n";
+}
+
+// Reads the option's value(s), or fails with a message.
+static bool NextArg(int argc, char* argv[], int& i, string& value) {
+    if (i + 1 >= argc) {
+        cerr << "Missing value for " << argv[i] << "\n";
+        return false;
+    }
+    value = argv[++i];
+    return true;
+}
+
+static bool ParseNumber(const string& text, double& value) {
+    char* end = nullptr;
+    value = strtod(text.c_str(), &end);
+    if (text.empty() || *end != '\0' || value < 0) {
+        cerr << "Invalid number: " << text << "\n";
+        return false;
+    }
+    return true;
+}
+
+static bool ParseCount(const string& text, size_t& value) {
+    double number = 0;
+    if (!ParseNumber(text, number)) return false;
+    value = static_cast<size_t>(number); // allows 1e6
+    return true;
+}
+
+static bool ParseRate(const string& text, double& value) {
+    if (!ParseNumber(text, value)) return false;
+    if (value > 1) {
+        cerr << "Rate must be between 0 and 1: " << text << "\n";
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    GeneratorOptions options;
+    string outputPath;
+
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        string value;
+        bool ok = true;
+        if (arg == "--help" || arg == "-h") {
+            PrintUsage();
+            return 0;
+        } else if (arg == "--long-keys") {
+            options.longKeys = true;
+        } else if (arg == "--title-words") {
+            string maxValue;
+            ok = NextArg(argc, argv, i, value) && NextArg(argc, argv, i, maxValue) &&
+                 ParseCount(value, options.minTitleWords) && ParseCount(maxValue, options.maxTitleWords);
+            if (ok && (options.minTitleWords == 0 || options.maxTitleWords < options.minTitleWords)) {
+                cerr << "Title words need 1 <= MIN <= MAX\n";
+                ok = false;
+            }
+        } else if (!NextArg(argc, argv, i, value)) {
+            ok = false;
+        } else if (arg == "--courses") {
+            ok = ParseCount(value, options.courses);
+        } else if (arg == "--seed") {
+            size_t seed = 0;
+            ok = ParseCount(value, seed);
+            options.seed = seed;
+        } else if (arg == "--order") {
+            if (value == "sorted") options.order = KeyOrder::Sorted;
+            else if (value == "random") options.order = KeyOrder::Random;
+            else if (value == "zigzag") options.order = KeyOrder::ZigZag;
+            else {
+                cerr << "Unknown order: " << value << "\n";
+                ok = false;
+            }
+        } else if (arg == "--sortedness") {
+            ok = ParseRate(value, options.sortedness);
+        } else if (arg == "--mean-prereqs") {
+            ok = ParseNumber(value, options.meanPrereqs);
+        } else if (arg == "--max-prereqs") {
+            ok = ParseCount(value, options.maxPrereqs);
+        } else if (arg == "--skew") {
+            ok = ParseNumber(value, options.prereqSkew);
+        } else if (arg == "--quoted-rate") {
+            ok = ParseRate(value, options.quotedRate);
+        } else if (arg == "--duplicate-rate") {
+            ok = ParseRate(value, options.duplicateRate);
+        } else if (arg == "--missing-rate") {
+            ok = ParseRate(value, options.missingRate);
+        } else if (arg == "--malformed-rate") {
+            ok = ParseRate(value, options.malformedRate);
+        } else if (arg == "--error-rate") {
+            ok = ParseRate(value, options.duplicateRate);
+            options.missingRate = options.malformedRate = options.duplicateRate;
+        } else if (arg == "-o" || arg == "--output") {
+            outputPath = value;
+        } else {
+            cerr << "Unknown option: " << arg << "\n";
+            ok = false;
+        }
+        if (!ok) {
+            PrintUsage();
+            return 2;
+        }
+    }
+
+    ofstream file;
+    if (!outputPath.empty()) {
+        file.open(outputPath, ios::binary);
+        if (!file) {
+            cerr << "Could not open file for writing: " << outputPath << "\n";
+            return 1;
+        }
+    }
+    ostream& out = outputPath.empty() ? cout : file;
+    ios::sync_with_stdio(false);
+
+    GeneratorStats stats = WriteSyntheticCatalog(out, options);
+    out.flush();
+    if (!out) {
+        cerr << "Write failed.\n";
+        return 1;
+    }
+
+    cerr << "Wrote " << stats.lines << " lines: " << stats.courses << " courses, "
+         << stats.prerequisites << " prerequisites, " << stats.duplicates << " duplicates, "
+         << stats.missing << " missing prerequisites, " << stats.malformed << " malformed lines.\n";
+    return 0;
+}
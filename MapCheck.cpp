@@ -0,0 +1,216 @@
+//============================================================================
+// Name        : MapCheck.cpp
+// Course      : CS 300 - DSA Design and Analysis
+// Description : Self check for OrderedMap (AA tree) and BPlusMap (ProjectTwo.cpp)
+//               against std::map. Every size from 0 to 300, then up to the
+//               maximum in steps, plus sizes either side of one leaf, one
+//               full inner node and two levels of them, inserted sorted,
+//               reversed, shuffled, zig-zag and with repeats. Checks Insert's
+//               return values, Size, the in order walk, Find hits and misses,
+//               re-inserts, and that the shape stays within its height bound.
+//               Run for both course key layouts and for int keys ordered by
+//               greater<int>.
+// Build       : g++ -std=c++17 -g -fsanitize=address,undefined -pthread MapCheck.cpp -o map_check
+// Usage       : ./map_check [max size]      (default 5000; exit status 1 on a mismatch)
+// Notes       : -Same approach as CsvCheck.cpp: ProjectTwo.cpp is included
+//                directly (its menu and main are compiled out). Both maps and
+//                both key layouts are always compiled, whatever the flags.
+//               -Run it under the sanitizers; node splits copy arrays around
+//                and an off by one there would not always show in the results.
+//============================================================================
+
+#define ABCU_NO_MAIN
+#include "ProjectTwo.cpp"
+
+#include <map>
+#include <random>
+
+// -------------------------------- Keys ---------------------------------------
+
+// Key number v for each key type, in the same order as v. Inserted keys use
+// even numbers from 2, so every odd number is a miss (1 sits below them all).
+static void MakeKey(int v, int& key) {
+    key = v;
+}
+
+// 14 characters, so both of the packed words take part in the compares.
+static void MakeKey(int v, GenericCourseKey& key) {
+    char text[24];
+    snprintf(text, sizeof text, "CS%012d", v);
+    GenericCourseKey::FromString(text, key);
+}
+
+// Four letters (v / 1000 in base 26) and three digits.
+static void MakeKey(int v, FixedCourseKey& key) {
+    char text[8];
+    int letters = v / 1000;
+    int digits = v % 1000;
+    for (int i = 3; i >= 0; --i, letters /= 26) text[i] = static_cast<char>('A' + letters % 26);
+    for (int i = 6; i >= 4; --i, digits /= 10) text[i] = static_cast<char>('0' + digits % 10);
+    FixedCourseKey::FromString(string_view(text, 7), key);
+}
+
+// ----------------------------- Insert Orders ---------------------------------
+
+static const char* const Orders[] = {"sorted", "reverse", "random", "zigzag", "repeats"};
+
+// Numbers 0..n-1 in the named order; "repeats" draws n from about n/2 of them.
+static vector<int> InsertOrder(const string& order, int n, mt19937& rng) {
+    vector<int> values(n);
+    for (int i = 0; i < n; ++i) values[i] = i;
+    if (order == "reverse") {
+        reverse(values.begin(), values.end());
+    } else if (order == "random") {
+        shuffle(values.begin(), values.end(), rng);
+    } else if (order == "zigzag") {
+        for (int i = 0, lo = 0, hi = n - 1; i < n; ++i) values[i] = i % 2 ? hi-- : lo++;
+    } else if (order == "repeats") {
+        for (int& v : values) v = static_cast<int>(rng() % (n / 2 + 1));
+    }
+    return values;
+}
+
+// 0..300, then steps up to maxSize, then one either side of the sizes where
+// a B+ tree fills a leaf, an inner node and a second level of inner nodes.
+static vector<int> Sizes(int leafCapacity, int fanout, int maxSize) {
+    vector<int> sizes;
+    for (int n = 0; n <= min(300, maxSize); ++n) sizes.push_back(n);
+    for (int n = 500; n <= maxSize; n += 250) sizes.push_back(n);
+    for (long long edge : {1LL * leafCapacity * fanout, 1LL * leafCapacity * fanout * fanout}) {
+        for (long long n = edge - 1; n <= edge + 1; ++n) {
+            if (n > 300 && n <= 40000) sizes.push_back(static_cast<int>(n));
+        }
+    }
+    return sizes;
+}
+
+// ------------------------------- Checks --------------------------------------
+
+static size_t CeilLog2(size_t n) {
+    size_t bits = 0;
+    while ((size_t(1) << bits) < n) ++bits;
+    return bits;
+}
+
+// An AA tree is never more than 2 log2(n + 1) levels deep.
+template <typename Key, typename Value, typename Compare>
+static string ShapeProblem(const OrderedMap<Key, Value, Compare>& map, size_t n, bool) {
+    const size_t height = map.Shape().height;
+    if (height > 2 * CeilLog2(n + 1)) return "height " + to_string(height) + " over 2 log2(n + 1)";
+    return "";
+}
+
+// A B+ tree needs at least n / LeafCapacity leaves, and exactly that many
+// when the keys came in key order (packed leaves). Every inner node off the
+// right edge has at least Fanout / 2 children, so height h needs
+// (Fanout / 2)^(h - 2) leaves.
+template <typename Key, typename Value, typename Compare>
+static string ShapeProblem(const BPlusMap<Key, Value, Compare>& map, size_t n, bool keyOrder) {
+    using Map = BPlusMap<Key, Value, Compare>;
+    const typename Map::ShapeStats shape = map.Shape();
+    if (n == 0) return shape.height == 0 ? "" : "empty map with height " + to_string(shape.height);
+
+    const size_t fewest = (n + Map::LeafCapacity - 1) / Map::LeafCapacity;
+    if (shape.leaves < fewest || shape.leaves > n) return to_string(shape.leaves) + " leaves";
+    if (keyOrder && shape.leaves != fewest) {
+        return "load in key order left " + to_string(shape.leaves) + " leaves, not " + to_string(fewest);
+    }
+    size_t needed = 1;
+    for (size_t h = 2; h < shape.height; ++h) needed *= Map::Fanout / 2;
+    if (shape.height > 1 && shape.leaves < needed) {
+        return "height " + to_string(shape.height) + " with only " + to_string(shape.leaves) + " leaves";
+    }
+    if (map.NodeBytes() > map.NodeCapacity()) return "node bytes over capacity";
+    return "";
+}
+
+template <typename Map, typename Key, typename Compare>
+static bool CheckMap(Map& map, const char* keyName, const string& order, const vector<int>& values) {
+    const string where = string(Map::Name) + ", " + keyName + " keys, " + order + ", n=" + to_string(values.size());
+    auto fail = [&](const string& what) {
+        cerr << "FAIL " << where << ": " << what << '\n';
+        return false;
+    };
+
+    map.Clear();
+    std::map<Key, int, Compare> expected;
+    bool keyOrder = true; // by the map's Compare, so "reverse" for greater<int>
+    Key previous{};
+    for (size_t i = 0; i < values.size(); ++i) {
+        Key key;
+        MakeKey(2 * values[i] + 2, key);
+        if (i > 0 && !Compare()(previous, key)) keyOrder = false;
+        previous = key;
+        const pair<int*, bool> got = map.Insert(key, static_cast<int>(i));
+        const auto want = expected.insert({key, static_cast<int>(i)});
+        if (got.second != want.second || *got.first != want.first->second) {
+            return fail("insert #" + to_string(i) + " of " + to_string(values[i]));
+        }
+    }
+    if (map.Size() != expected.size() || map.Empty() != expected.empty()) {
+        return fail("size " + to_string(map.Size()) + ", expected " + to_string(expected.size()));
+    }
+
+    auto next = expected.begin();
+    bool inOrder = true;
+    map.ForEachInOrder([&](const Key& key, int value) {
+        if (!inOrder || next == expected.end() || !(key == next->first) || value != next->second) {
+            inOrder = false;
+            return;
+        }
+        ++next;
+    });
+    if (!inOrder || next != expected.end()) return fail("in order walk differs");
+
+    for (const auto& entry : expected) {
+        size_t comparisons = 0;
+        const int* value = map.Find(entry.first, comparisons);
+        if (!value || *value != entry.second || comparisons == 0) return fail("find of an inserted key");
+    }
+    for (size_t v = 0; v <= values.size(); ++v) {
+        Key key;
+        MakeKey(static_cast<int>(2 * v + 1), key);
+        if (map.Find(key)) return fail("found " + to_string(2 * v + 1) + ", which was never inserted");
+    }
+
+    // A second insert keeps the first value and reports it.
+    for (const auto& entry : expected) {
+        const pair<int*, bool> again = map.Insert(entry.first, -1);
+        if (again.second || *again.first != entry.second) return fail("re-insert");
+    }
+    if (map.Size() != expected.size()) return fail("size changed on re-insert");
+
+    const string shape = ShapeProblem(map, expected.size(), keyOrder);
+    return shape.empty() ? true : fail(shape);
+}
+
+// One map type through every size and order. The map is reused (Clear keeps
+// its capacity), as CourseBST reuses its index across loads.
+template <typename Map, typename Key, typename Compare>
+static bool CheckAll(const char* keyName, const vector<int>& sizes) {
+    mt19937 rng(12345);
+    Map map;
+    for (int n : sizes) {
+        for (const char* order : Orders) {
+            if (!CheckMap<Map, Key, Compare>(map, keyName, order, InsertOrder(order, n, rng))) return false;
+        }
+    }
+    return true;
+}
+
+template <typename Key, typename Compare = less<Key>>
+static bool CheckKeyType(const char* keyName, int maxSize) {
+    using Tree = OrderedMap<Key, int, Compare>;
+    using BTree = BPlusMap<Key, int, Compare>;
+    const vector<int> sizes = Sizes(BTree::LeafCapacity, BTree::Fanout, maxSize);
+    return CheckAll<Tree, Key, Compare>(keyName, sizes) && CheckAll<BTree, Key, Compare>(keyName, sizes);
+}
+
+int main(int argc, char* argv[]) {
+    const int maxSize = argc > 1 ? atoi(argv[1]) : 5000;
+    const bool ok = CheckKeyType<GenericCourseKey>("generic", maxSize) &&
+                    CheckKeyType<FixedCourseKey>("fixed", maxSize) &&
+                    CheckKeyType<int, greater<int>>("int (greater)", maxSize);
+    cout << (ok ? "ok" : "FAILED") << '\n';
+    return ok ? 0 : 1;
+}
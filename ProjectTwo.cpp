@@ -8,241 +8,3364 @@
 //                 1) Load Data Structure
 //                 2) Print Course List (sorted alphanumeric)
 //                 3) Print a Single Course (title and prerequisites)
-// Notes       : -No external CSV parser; I split on commas and trim.
+//                 4) Plan Semesters (prerequisite ordered, per term limit)
+//                 5) Check Eligibility (courses a student can take next)
+//                 6) Cohort Eligibility (a whole student file, in parallel)
+//                 7) Find Course (typo tolerant number or title search)
+//                 8) Search Course Titles (all words, prefix match)
+//                10) Load Report (time per load phase, bytes, allocations)
+//                11) Tree Statistics (height, search depth, memory per column)
+//                12) Query Metrics (latency percentiles, hits/misses, comparisons)
+//               Batch mode runs one command and exits:
+//                 ProjectTwo <courses.csv> list | course <number> | search <words...>
+//               (add --load-stats / --query-stats for JSON reports on stderr)
+//               ProjectTwo --course-cache=N sizes the hot course cache (0 = off).
+// Build       : g++ -std=c++17 -O2 -pthread ProjectTwo.cpp
+//               (plain C++17, no GCC extensions needed: clang++, or MSVC with /std:c++17)
+//               Optional compressed input: add -DABCU_WITH_ZLIB -lz (gzip)
+//               and/or -DABCU_WITH_ZSTD -lzstd (zstd).
+// Notes       : -No external CSV parser; CsvReader handles RFC 4180 quoting
+//                (titles like "Data Structures, Part II") and trims unquoted fields.
 //               -I uppercase course numbers so user input is case insensitive.
-//               -BST in order traversal prints the list already sorted.
+//                They are stored as fixed 16 byte keys (CourseKey), not strings;
+//                -DABCU_FIXED_COURSE_CODES packs ABCU style codes (CSCI300)
+//                into 4 bytes instead and rejects any other shape.
+//               -Load Data also takes several files (a folder, a wildcard, or
+//                paths separated by ';') and merges them into one catalog.
+//               -BST in order traversal prints the list already sorted. The
+//                index is a B+ tree (BPlusMap) with cache line sized nodes and
+//                linked leaves; -DABCU_AA_TREE_INDEX swaps in the balanced
+//                binary AA tree (OrderedMap). Either way a sorted course file
+//                no longer turns it into a linked list.
 //               -For prerequisites, I print codes in the order given in the file
 //                to match the sample output.
+//               -Validation reports missing prerequisites and prerequisite
+//                cycles (Tarjan SCC over the resolved course graph).
 //============================================================================
 
 #include <iostream>
 #include <fstream>
-#include <sstream>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <cctype>
 #include <algorithm>
+#include <iterator>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <unordered_map>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <atomic>
+#include <filesystem>
+#include <chrono>
+#include <iomanip>
+#include <cstdlib>
+#include <new>
+#include <sstream>
+
+#ifdef ABCU_WITH_ZLIB
+#include <zlib.h>
+#endif
+#ifdef ABCU_WITH_ZSTD
+#include <zstd.h>
+#endif
+#ifdef _MSC_VER
+#include <intrin.h>
+#include <malloc.h>
+#endif
+
+using namespace std;
+
+// ------------------------------- Portability ---------------------------------
+
+// The few compiler specific bits, so the rest stays plain C++17 and builds
+// with GCC, Clang or MSVC (anything else gets the slow but correct loops).
+
+#if defined(__GNUC__)
+#define ABCU_NOINLINE __attribute__((noinline))
+#elif defined(_MSC_VER)
+#define ABCU_NOINLINE __declspec(noinline)
+#else
+#define ABCU_NOINLINE
+#endif
+
+// Index of the highest / lowest set bit. v must not be 0.
+static inline int HighestBit(uint64_t v) {
+#if defined(__GNUC__)
+    return 63 - __builtin_clzll(v);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+    unsigned long index;
+    _BitScanReverse64(&index, v);
+    return static_cast<int>(index);
+#else
+    int index = 0;
+    while (v >>= 1) ++index;
+    return index;
+#endif
+}
+
+static inline int LowestBit(uint64_t v) {
+#if defined(__GNUC__)
+    return __builtin_ctzll(v);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+    unsigned long index;
+    _BitScanForward64(&index, v);
+    return static_cast<int>(index);
+#else
+    int index = 0;
+    while (!(v & 1)) {
+        v >>= 1;
+        ++index;
+    }
+    return index;
+#endif
+}
+
+// --------------------------- Utility helpers --------------------------------
+
+// The parsing helpers work on string_view so the loader and query paths
+// don't allocate per token: views point into the caller's line buffer and
+// stay valid until that buffer changes.
+
+// trimView: remove leading/trailing whitespace, without copying
+static inline string_view trimView(string_view s) {
+    size_t start = 0, end = s.size();
+    while (start < end && isspace(static_cast<unsigned char>(s[start]))) ++start;
+    while (end > start && isspace(static_cast<unsigned char>(s[end - 1]))) --end;
+    return s.substr(start, end - start);
+}
+
+// trim: owning version for menu input
+static inline string trim(const string& s) {
+    return string(trimView(s));
+}
+
+// split a CSV line by ',' and trim each token. No quote handling: CsvReader
+// only sends lines without a '"' here, and menu input is lists of course numbers.
+// out is the caller's, cleared and refilled, so once it has grown no line allocates.
+// A trailing comma gives a final empty token, same as before.
+static void splitCSV(string_view line, vector<string_view>& out) {
+    out.clear();
+    size_t start = 0;
+    while (true) {
+        size_t comma = line.find(',', start);
+        if (comma == string_view::npos) {
+            out.push_back(trimView(line.substr(start)));
+            return;
+        }
+        out.push_back(trimView(line.substr(start, comma - start)));
+        start = comma + 1;
+    }
+}
+
+static void upperInPlace(string& s) {
+    for (char& ch : s) ch = static_cast<char>(toupper(static_cast<unsigned char>(ch)));
+}
+
+// uppercase a course number so comparisons/user input are consistent
+static string upperCopy(string_view s) {
+    string out(s);
+    upperInPlace(out);
+    return out;
+}
+
+// ------------------------------ Instrumentation ------------------------------
+
+// Every load records where its time went (see LoadStats), so a slow load
+// can be blamed on the right phase. The counters are cheap enough to leave on.
+
+using Clock = chrono::steady_clock;
+
+static double MillisecondsSince(Clock::time_point start) {
+    return chrono::duration<double, milli>(Clock::now() - start).count();
+}
+
+// Global allocation counter: every operator new in the program (all threads)
+// bumps two relaxed atomics. Build with -DABCU_NO_ALLOC_COUNT to drop it.
+struct AllocationCount {
+    uint64_t allocations = 0;
+    uint64_t bytes = 0;
+};
+
+#ifndef ABCU_NO_ALLOC_COUNT
+static atomic<uint64_t> allocationTotal(0), allocatedBytesTotal(0);
+
+// Every plain and array, throwing and nothrow form comes through here so
+// allocations and frees always pair up (malloc/free).
+static void* countedAlloc(size_t size) noexcept {
+    allocationTotal.fetch_add(1, memory_order_relaxed);
+    allocatedBytesTotal.fetch_add(size, memory_order_relaxed);
+    return malloc(size == 0 ? 1 : size);
+}
+
+static void* countedNew(size_t size) {
+    while (true) {
+        if (void* p = countedAlloc(size)) return p;
+        new_handler handler = get_new_handler();
+        if (!handler) throw bad_alloc();
+        handler();
+    }
+}
+
+void* operator new(size_t size) { return countedNew(size); }
+void* operator new[](size_t size) { return countedNew(size); }
+void* operator new(size_t size, const nothrow_t&) noexcept { return countedAlloc(size); }
+void* operator new[](size_t size, const nothrow_t&) noexcept { return countedAlloc(size); }
+
+// Kept out of line: once inlined, GCC pairs the free with the new expression
+// and warns about a mismatch that isn't there.
+ABCU_NOINLINE void operator delete(void* p) noexcept { free(p); }
+ABCU_NOINLINE void operator delete[](void* p) noexcept { free(p); }
+ABCU_NOINLINE void operator delete(void* p, size_t) noexcept { free(p); }
+ABCU_NOINLINE void operator delete[](void* p, size_t) noexcept { free(p); }
+ABCU_NOINLINE void operator delete(void* p, const nothrow_t&) noexcept { free(p); }
+ABCU_NOINLINE void operator delete[](void* p, const nothrow_t&) noexcept { free(p); }
+
+// Over-aligned types (the B+ tree's cache line nodes) come through the
+// align_val_t forms instead. Counted the same way, and freed by the matching
+// call, since MSVC can't free an aligned block with plain free.
+static void* countedAlignedAlloc(size_t size, align_val_t align) noexcept {
+    allocationTotal.fetch_add(1, memory_order_relaxed);
+    allocatedBytesTotal.fetch_add(size, memory_order_relaxed);
+    const size_t alignment = static_cast<size_t>(align);
+#ifdef _MSC_VER
+    return _aligned_malloc(size == 0 ? 1 : size, alignment);
+#else
+    // aligned_alloc wants a whole number of alignment units.
+    return aligned_alloc(alignment, (max<size_t>(size, 1) + alignment - 1) & ~(alignment - 1));
+#endif
+}
+
+static void alignedFree(void* p) noexcept {
+#ifdef _MSC_VER
+    _aligned_free(p);
+#else
+    free(p);
+#endif
+}
+
+static void* countedAlignedNew(size_t size, align_val_t align) {
+    while (true) {
+        if (void* p = countedAlignedAlloc(size, align)) return p;
+        new_handler handler = get_new_handler();
+        if (!handler) throw bad_alloc();
+        handler();
+    }
+}
+
+void* operator new(size_t size, align_val_t align) { return countedAlignedNew(size, align); }
+void* operator new[](size_t size, align_val_t align) { return countedAlignedNew(size, align); }
+void* operator new(size_t size, align_val_t align, const nothrow_t&) noexcept { return countedAlignedAlloc(size, align); }
+void* operator new[](size_t size, align_val_t align, const nothrow_t&) noexcept { return countedAlignedAlloc(size, align); }
+
+ABCU_NOINLINE void operator delete(void* p, align_val_t) noexcept { alignedFree(p); }
+ABCU_NOINLINE void operator delete[](void* p, align_val_t) noexcept { alignedFree(p); }
+ABCU_NOINLINE void operator delete(void* p, size_t, align_val_t) noexcept { alignedFree(p); }
+ABCU_NOINLINE void operator delete[](void* p, size_t, align_val_t) noexcept { alignedFree(p); }
+ABCU_NOINLINE void operator delete(void* p, align_val_t, const nothrow_t&) noexcept { alignedFree(p); }
+ABCU_NOINLINE void operator delete[](void* p, align_val_t, const nothrow_t&) noexcept { alignedFree(p); }
+
+static AllocationCount CurrentAllocations() {
+    AllocationCount now;
+    now.allocations = allocationTotal.load(memory_order_relaxed);
+    now.bytes = allocatedBytesTotal.load(memory_order_relaxed);
+    return now;
+}
+#else
+static AllocationCount CurrentAllocations() { return AllocationCount(); }
+#endif
+
+// One load, phase by phase. For a single file, parsing and inserting are
+// interleaved, so insert is the time spent inside the tree's Emplace and
+// parse is the rest. With several files, parse is the parallel read of all
+// of them (opening included) and insert is the merge.
+struct LoadStats {
+    bool ok = false;
+    size_t files = 0;
+    uint64_t fileBytes = 0;   // on disk, compressed if the file is
+    uint64_t bytesParsed = 0; // what the CSV reader saw, after decompression
+    size_t lines = 0;
+    size_t records = 0;       // valid course lines
+    size_t courses = 0;       // in the catalog, after duplicates
+    size_t issues = 0;
+    size_t treeHeight = 0;    // see CourseBST::Stats
+    double averageDepth = 0;
+
+    double openMs = 0;        // expanding the file spec and opening the file
+    double parseMs = 0;
+    double insertMs = 0;
+    double validateMs = 0;    // compaction, prerequisite graph and cycle check
+    double indexMs = 0;       // eligibility, fuzzy and title indexes
+    double totalMs = 0;
+
+    AllocationCount allocated;
+
+    double LinesPerSecond() const {
+        double ms = parseMs + insertMs;
+        return ms > 0 ? lines * 1000.0 / ms : 0;
+    }
+};
+
+[[maybe_unused]]
+static void PrintLoadStats(ostream& out, const LoadStats& stats) {
+    const double MB = 1024.0 * 1024.0;
+    out << fixed << setprecision(1)
+        << "\nLoad Report (" << stats.files << (stats.files == 1 ? " file, " : " files, ")
+        << stats.fileBytes / MB << " MB on disk, " << stats.bytesParsed / MB << " MB parsed)"
+        << (stats.ok ? "" : " - load failed") << '\n';
+    const pair<const char*, double> phases[] = {
+        {"open", stats.openMs}, {"parse", stats.parseMs}, {"insert", stats.insertMs},
+        {"validate", stats.validateMs}, {"index", stats.indexMs}, {"total", stats.totalMs}
+    };
+    out << setprecision(3);
+    for (const auto& phase : phases) {
+        out << "  " << left << setw(10) << phase.first << right << setw(12) << phase.second << " ms\n";
+    }
+    out << setprecision(0)
+        << "  Lines: " << stats.lines << " (" << stats.LinesPerSecond() << " lines/s)\n"
+        << "  Courses: " << stats.courses << " of " << stats.records << " records, "
+        << stats.issues << " validation issues\n"
+        << "  Tree: height " << stats.treeHeight << ", average depth " << setprecision(1)
+        << stats.averageDepth << " (Option 11 for details)\n"
+        << "  Allocations: " << stats.allocated.allocations << " (" << setprecision(1)
+        << stats.allocated.bytes / MB << " MB)\n";
+    out << defaultfloat << setprecision(6);
+}
+
+// Same numbers as one JSON object on one line, for scripts.
+[[maybe_unused]]
+static void WriteLoadStatsJson(ostream& out, const LoadStats& stats) {
+    out << fixed << setprecision(3)
+        << "{\"ok\":" << (stats.ok ? "true" : "false")
+        << ",\"files\":" << stats.files
+        << ",\"file_bytes\":" << stats.fileBytes
+        << ",\"bytes_parsed\":" << stats.bytesParsed
+        << ",\"lines\":" << stats.lines
+        << ",\"records\":" << stats.records
+        << ",\"courses\":" << stats.courses
+        << ",\"issues\":" << stats.issues
+        << ",\"tree_height\":" << stats.treeHeight
+        << ",\"average_depth\":" << stats.averageDepth
+        << ",\"phases_ms\":{\"open\":" << stats.openMs
+        << ",\"parse\":" << stats.parseMs
+        << ",\"insert\":" << stats.insertMs
+        << ",\"validate\":" << stats.validateMs
+        << ",\"index\":" << stats.indexMs
+        << ",\"total\":" << stats.totalMs << '}'
+        << ",\"lines_per_sec\":" << setprecision(0) << stats.LinesPerSecond()
+        << ",\"allocations\":" << stats.allocated.allocations
+        << ",\"allocated_bytes\":" << stats.allocated.bytes << "}\n";
+    out << defaultfloat << setprecision(6);
+}
+
+// Lock-free log-linear histogram (HDR style): values below 16 get their own
+// bucket, above that every power of two is split into 16 sub-buckets, so any
+// reading is within about 6% for the whole uint64 range in 976 counters.
+// Record is a few relaxed atomic adds, safe from any number of threads.
+class Histogram {
+public:
+    static constexpr int SubBucketBits = 4;
+    static constexpr int SubBuckets = 1 << SubBucketBits;
+    static constexpr int BucketCount = (64 - SubBucketBits + 1) * SubBuckets;
+
+private:
+    atomic<uint64_t> counts[BucketCount] = {};
+    atomic<uint64_t> total{0}, sum{0}, maximum{0};
+
+    static int bucketOf(uint64_t v) {
+        if (v < SubBuckets) return static_cast<int>(v);
+        const int exponent = HighestBit(v);
+        const int sub = static_cast<int>((v >> (exponent - SubBucketBits)) & (SubBuckets - 1));
+        return (exponent - SubBucketBits + 1) * SubBuckets + sub;
+    }
+
+    // Largest value that lands in bucket i.
+    static uint64_t bucketHigh(int i) {
+        if (i < SubBuckets) return static_cast<uint64_t>(i);
+        const int exponent = i / SubBuckets + SubBucketBits - 1;
+        const uint64_t low = static_cast<uint64_t>(SubBuckets + i % SubBuckets) << (exponent - SubBucketBits);
+        return low + (uint64_t(1) << (exponent - SubBucketBits)) - 1;
+    }
+
+public:
+    void Record(uint64_t v) {
+        counts[bucketOf(v)].fetch_add(1, memory_order_relaxed);
+        total.fetch_add(1, memory_order_relaxed);
+        sum.fetch_add(v, memory_order_relaxed);
+        uint64_t seen = maximum.load(memory_order_relaxed);
+        while (v > seen && !maximum.compare_exchange_weak(seen, v, memory_order_relaxed)) {}
+    }
+
+    uint64_t Count() const { return total.load(memory_order_relaxed); }
+    uint64_t Max() const { return maximum.load(memory_order_relaxed); }
+    double Mean() const {
+        const uint64_t n = Count();
+        return n ? static_cast<double>(sum.load(memory_order_relaxed)) / n : 0;
+    }
+
+    // Value at or below which fraction p (0..1) of readings fall, rounded
+    // up to its bucket's top. Concurrent Records may or may not be included.
+    uint64_t Percentile(double p) const {
+        const uint64_t n = Count();
+        if (n == 0) return 0;
+        uint64_t rank = static_cast<uint64_t>(p * n + 0.5);
+        if (rank == 0) rank = 1;
+        uint64_t seen = 0;
+        for (int i = 0; i < BucketCount; ++i) {
+            seen += counts[i].load(memory_order_relaxed);
+            if (seen >= rank) return min(bucketHigh(i), Max());
+        }
+        return Max();
+    }
+};
+
+// One kind of query: how often it ran, whether it found the course,
+// how long it took and how many tree nodes it compared against.
+struct OperationMetrics {
+    const char* name;
+    atomic<uint64_t> hits{0}, misses{0};
+    Histogram latencyNs;
+    Histogram comparisons;
+
+    explicit OperationMetrics(const char* opName) : name(opName) {}
+
+    void Record(Clock::time_point start, bool hit, uint64_t compared) {
+        latencyNs.Record(static_cast<uint64_t>(chrono::duration_cast<chrono::nanoseconds>(Clock::now() - start).count()));
+        comparisons.Record(compared);
+        (hit ? hits : misses).fetch_add(1, memory_order_relaxed);
+    }
+};
+
+// User facing queries since the program started (not reset by a reload):
+// search is each course number looked up for the user, course is a whole
+// PrintCourse (a miss is "Course not found."), list is a full listing.
+struct QueryMetrics {
+    OperationMetrics search{"search"};
+    OperationMetrics course{"course"};
+    OperationMetrics list{"list"};
+};
+
+static QueryMetrics queryMetrics;
+
+[[maybe_unused]]
+static void PrintQueryMetrics(ostream& out, const QueryMetrics& metrics) {
+    out << "\nQuery Metrics (latency in ns):\n"
+        << "  " << left << setw(8) << "op" << right << setw(10) << "calls" << setw(10) << "hits"
+        << setw(10) << "misses" << setw(10) << "p50" << setw(10) << "p90" << setw(10) << "p99"
+        << setw(12) << "max" << setw(10) << "cmp avg" << setw(9) << "cmp p99" << '\n';
+    for (const OperationMetrics* op : {&metrics.search, &metrics.course, &metrics.list}) {
+        const Histogram& h = op->latencyNs;
+        out << "  " << left << setw(8) << op->name << right << setw(10) << h.Count()
+            << setw(10) << op->hits.load(memory_order_relaxed) << setw(10) << op->misses.load(memory_order_relaxed)
+            << setw(10) << h.Percentile(0.50) << setw(10) << h.Percentile(0.90) << setw(10) << h.Percentile(0.99)
+            << setw(12) << h.Max() << fixed << setprecision(1) << setw(10) << op->comparisons.Mean()
+            << defaultfloat << setprecision(6) << setw(9) << op->comparisons.Percentile(0.99) << '\n';
+    }
+}
+
+[[maybe_unused]]
+static void WriteQueryMetricsJson(ostream& out, const QueryMetrics& metrics) {
+    out << '{';
+    bool first = true;
+    for (const OperationMetrics* op : {&metrics.search, &metrics.course, &metrics.list}) {
+        const Histogram& h = op->latencyNs;
+        out << (first ? "" : ",") << '"' << op->name << "\":{\"calls\":" << h.Count()
+            << ",\"hits\":" << op->hits.load(memory_order_relaxed)
+            << ",\"misses\":" << op->misses.load(memory_order_relaxed)
+            << ",\"latency_ns\":{\"p50\":" << h.Percentile(0.50) << ",\"p90\":" << h.Percentile(0.90)
+            << ",\"p99\":" << h.Percentile(0.99) << ",\"p999\":" << h.Percentile(0.999)
+            << ",\"max\":" << h.Max() << ",\"mean\":" << fixed << setprecision(1) << h.Mean() << '}'
+            << ",\"comparisons\":{\"mean\":" << op->comparisons.Mean() << defaultfloat << setprecision(6)
+            << ",\"p99\":" << op->comparisons.Percentile(0.99) << ",\"max\":" << op->comparisons.Max() << "}}";
+        first = false;
+    }
+    out << "}\n";
+}
+
+// ------------------------------- Input Sources -------------------------------
+
+// Where CsvReader gets its bytes. Read fills up to n bytes and returns how
+// many it wrote; 0 means end of input, or failure if Error() is non-empty.
+class ByteSource {
+public:
+    virtual ~ByteSource() = default;
+    virtual size_t Read(char* dst, size_t n) = 0;
+    const string& Error() const { return error; }
+
+protected:
+    string error;
+};
+
+// Plain file or any other stream, read straight into the caller's buffer.
+class StreamSource : public ByteSource {
+private:
+    unique_ptr<istream> owned;
+    istream& in;
+
+public:
+    explicit StreamSource(istream& input) : in(input) {}
+    explicit StreamSource(unique_ptr<istream> input) : owned(move(input)), in(*owned) {}
+
+    size_t Read(char* dst, size_t n) override {
+        in.read(dst, static_cast<streamsize>(n));
+        if (in.bad()) error = "read error";
+        return static_cast<size_t>(in.gcount());
+    }
+};
+
+// Compressed catalog exports are decoded while they're parsed, so there is
+// no temporary file and no second trip to disk. Both decoders are opt in,
+// since they need an extra library at link time:
+//   -DABCU_WITH_ZLIB -lz       gzip (.gz)
+//   -DABCU_WITH_ZSTD -lzstd    zstd (.zst)
+static const size_t CompressedBlockSize = 1 << 18;
+
+#ifdef ABCU_WITH_ZLIB
+class GzipSource : public ByteSource {
+private:
+    unique_ptr<istream> in;
+    vector<char> block;
+    z_stream zs{};
+    bool done = false;
+
+public:
+    explicit GzipSource(unique_ptr<istream> input) : in(move(input)), block(CompressedBlockSize) {
+        // 15 + 32: largest window, gzip or zlib header detected automatically.
+        if (inflateInit2(&zs, 15 + 32) != Z_OK) {
+            error = "gzip: cannot initialise decoder";
+            done = true;
+        }
+    }
+    ~GzipSource() override { inflateEnd(&zs); }
+
+    size_t Read(char* dst, size_t n) override {
+        zs.next_out = reinterpret_cast<Bytef*>(dst);
+        zs.avail_out = static_cast<uInt>(n);
+        while (!done && zs.avail_out > 0) {
+            if (zs.avail_in == 0) {
+                in->read(block.data(), static_cast<streamsize>(block.size()));
+                zs.next_in = reinterpret_cast<Bytef*>(block.data());
+                zs.avail_in = static_cast<uInt>(in->gcount());
+                if (zs.avail_in == 0) {
+                    error = "gzip: unexpected end of file";
+                    done = true;
+                    break;
+                }
+            }
+            int rc = inflate(&zs, Z_NO_FLUSH);
+            if (rc == Z_STREAM_END) {
+                // Concatenated .gz members are one file: keep going if more follows.
+                if (zs.avail_in == 0 && in->peek() == char_traits<char>::eof()) done = true;
+                else inflateReset(&zs);
+            } else if (rc != Z_OK && rc != Z_BUF_ERROR) {
+                error = string("gzip: ") + (zs.msg ? zs.msg : "corrupt data");
+                done = true;
+            }
+        }
+        return n - zs.avail_out;
+    }
+};
+#endif
+
+#ifdef ABCU_WITH_ZSTD
+class ZstdSource : public ByteSource {
+private:
+    unique_ptr<istream> in;
+    vector<char> block;
+    ZSTD_DStream* ds;
+    ZSTD_inBuffer input{nullptr, 0, 0};
+    bool inputEnded = false;
+    bool done = false;
+    bool midFrame = false;
+
+public:
+    explicit ZstdSource(unique_ptr<istream> stream) : in(move(stream)), block(CompressedBlockSize), ds(ZSTD_createDStream()) {
+        if (!ds || ZSTD_isError(ZSTD_initDStream(ds))) {
+            error = "zstd: cannot initialise decoder";
+            done = true;
+        }
+    }
+    ~ZstdSource() override { ZSTD_freeDStream(ds); }
+
+    size_t Read(char* dst, size_t n) override {
+        ZSTD_outBuffer output{dst, n, 0};
+        while (!done && output.pos < output.size) {
+            if (input.pos == input.size && !inputEnded) {
+                in->read(block.data(), static_cast<streamsize>(block.size()));
+                input = ZSTD_inBuffer{block.data(), static_cast<size_t>(in->gcount()), 0};
+                inputEnded = input.size == 0;
+            }
+            // With the file used up the decoder may still hold output, so it
+            // is called until it neither reads nor writes anything.
+            const size_t consumed = input.pos, produced = output.pos;
+            size_t rc = ZSTD_decompressStream(ds, &output, &input);
+            if (ZSTD_isError(rc)) {
+                error = string("zstd: ") + ZSTD_getErrorName(rc);
+                done = true;
+            } else if (input.pos == consumed && output.pos == produced) {
+                if (midFrame) error = "zstd: unexpected end of file";
+                done = true;
+            } else {
+                midFrame = rc != 0; // 0 = a frame just finished and is fully flushed
+            }
+        }
+        return output.pos;
+    }
+};
+#endif
+
+// Two stage load pipeline: a reader thread pulls blocks from the inner
+// source (disk, network mount, decompressor) into a bounded queue while the
+// parser consumes earlier ones, so load time tends to max(I/O, parse)
+// instead of their sum. Blocks are recycled, so the queue depth caps memory.
+class ReadAheadSource : public ByteSource {
+private:
+    static const size_t BlockSize = 1 << 20;
+    static const size_t QueueDepth = 4;
+
+    unique_ptr<ByteSource> inner;
+    mutex lock;
+    condition_variable changed;
+    deque<vector<char>> ready;        // filled, in file order
+    vector<vector<char>> spare;       // drained, waiting to be refilled
+    bool finished = false;            // reader hit end of input (or an error)
+    bool stopping = false;            // consumer is gone
+    string innerError;
+    vector<char> current;
+    size_t currentPos = 0;
+    thread reader;
+
+    void readLoop() {
+        while (true) {
+            vector<char> block;
+            {
+                unique_lock<mutex> guard(lock);
+                changed.wait(guard, [this] { return stopping || !spare.empty(); });
+                if (stopping) return;
+                block = move(spare.back());
+                spare.pop_back();
+            }
+
+            // Fill the whole block; small reads from the inner source are common.
+            block.resize(BlockSize);
+            size_t filled = 0;
+            while (filled < BlockSize) {
+                size_t got = inner->Read(block.data() + filled, BlockSize - filled);
+                if (got == 0) break;
+                filled += got;
+            }
+            block.resize(filled);
+
+            unique_lock<mutex> guard(lock);
+            if (filled > 0) ready.push_back(move(block));
+            if (filled < BlockSize) {
+                finished = true;
+                innerError = inner->Error();
+            }
+            changed.notify_all();
+            if (finished) return;
+        }
+    }
+
+public:
+    explicit ReadAheadSource(unique_ptr<ByteSource> source) : inner(move(source)) {
+        spare.resize(QueueDepth);
+        reader = thread(&ReadAheadSource::readLoop, this);
+    }
+
+    ~ReadAheadSource() override {
+        {
+            lock_guard<mutex> guard(lock);
+            stopping = true;
+        }
+        changed.notify_all();
+        reader.join();
+    }
+
+    size_t Read(char* dst, size_t n) override {
+        size_t copied = 0;
+        while (copied < n) {
+            if (currentPos == current.size()) {
+                unique_lock<mutex> guard(lock);
+                if (current.capacity() > 0) {
+                    spare.push_back(move(current));
+                    changed.notify_all();
+                }
+                current.clear();
+                currentPos = 0;
+                // Hand back what we have rather than stall on the reader.
+                if (copied > 0 && ready.empty()) break;
+                changed.wait(guard, [this] { return finished || !ready.empty(); });
+                if (ready.empty()) {
+                    error = innerError;
+                    break;
+                }
+                current = move(ready.front());
+                ready.pop_front();
+            }
+            size_t take = min(n - copied, current.size() - currentPos);
+            memcpy(dst + copied, current.data() + currentPos, take);
+            copied += take;
+            currentPos += take;
+        }
+        return copied;
+    }
+};
+
+// Files at least this big are read ahead on a separate thread; below it
+// the whole file fits in the parser's first few reads anyway.
+static const streamoff ReadAheadThreshold = 1 << 20;
+
+static unique_ptr<ByteSource> OpenDecoder(const string& filePath, unique_ptr<istream> file, string& error);
+
+// Open a course or student file, choosing a decoder from its first bytes
+// rather than its name. nullptr with a message in error on failure.
+static unique_ptr<ByteSource> OpenInputSource(const string& filePath, string& error) {
+    unique_ptr<istream> file(new ifstream(filePath, ios::binary));
+    if (!static_cast<ifstream&>(*file).is_open()) {
+        error = "Error: cannot open file '" + filePath + "'.";
+        return nullptr;
+    }
+
+    file->seekg(0, ios::end);
+    const streamoff size = file->tellg();
+    file->seekg(0);
+
+    unique_ptr<ByteSource> source = OpenDecoder(filePath, move(file), error);
+    if (source && size >= ReadAheadThreshold) {
+        // Decompression runs on the reader thread too, overlapping with parsing.
+        source.reset(new ReadAheadSource(move(source)));
+    }
+    return source;
+}
+
+// filePath and error are only used for a format this build can't decode.
+static unique_ptr<ByteSource> OpenDecoder([[maybe_unused]] const string& filePath, unique_ptr<istream> file,
+                                          [[maybe_unused]] string& error) {
+    unsigned char magic[4] = {0, 0, 0, 0};
+    file->read(reinterpret_cast<char*>(magic), sizeof magic);
+    file->clear();
+    file->seekg(0);
+
+    const bool gzip = magic[0] == 0x1F && magic[1] == 0x8B;
+    const bool zstd = magic[0] == 0x28 && magic[1] == 0xB5 && magic[2] == 0x2F && magic[3] == 0xFD;
+    if (gzip) {
+#ifdef ABCU_WITH_ZLIB
+        return unique_ptr<ByteSource>(new GzipSource(move(file)));
+#else
+        error = "Error: '" + filePath + "' is gzip compressed; rebuild with -DABCU_WITH_ZLIB -lz to read it.";
+        return nullptr;
+#endif
+    }
+    if (zstd) {
+#ifdef ABCU_WITH_ZSTD
+        return unique_ptr<ByteSource>(new ZstdSource(move(file)));
+#else
+        error = "Error: '" + filePath + "' is zstd compressed; rebuild with -DABCU_WITH_ZSTD -lzstd to read it.";
+        return nullptr;
+#endif
+    }
+    return unique_ptr<ByteSource>(new StreamSource(move(file)));
+}
+
+// ------------------------------- CSV Reader ----------------------------------
+
+// RFC 4180 CSV records from a ByteSource: quoted fields, "" escapes, commas and
+// newlines inside quotes, CRLF or LF line ends. Input is read in large blocks
+// and fields come back as views into the block, so nothing is allocated per
+// record. Lines without a '"' take the same split as splitCSV, so plain files
+// cost what they did before; only quoted lines go through the state machine.
+// Unquoted fields are trimmed like before; quoted text is kept as written.
+class CsvReader {
+private:
+    ByteSource& in;
+    string buf;
+    size_t pos = 0, end = 0;
+    bool eof = false;
+    size_t nextLine = 1;
+    size_t recordLine = 0;
+    bool unterminated = false;
+    uint64_t bytesRead = 0;
+
+    // Keep the unread tail and read more behind it, growing if one record
+    // is bigger than the whole buffer. False once the stream has nothing left.
+    bool refill() {
+        if (eof) return false;
+        if (pos > 0) {
+            memmove(&buf[0], buf.data() + pos, end - pos);
+            end -= pos;
+            pos = 0;
+        }
+        if (end == buf.size()) buf.resize(buf.size() * 2);
+        size_t got = in.Read(&buf[end], buf.size() - end);
+        end += got;
+        bytesRead += got;
+        if (got == 0) eof = true;
+        return got > 0;
+    }
+
+    // Split a complete quoted record in place. Unescaping only ever shrinks
+    // text, so it is written back over the bytes already read.
+    void splitQuoted(size_t first, size_t last, vector<string_view>& fields) {
+        char* data = &buf[0];
+        size_t r = first;
+        while (true) {
+            while (r < last && (data[r] == ' ' || data[r] == '\t')) ++r;
+            if (r < last && data[r] == '"') {
+                size_t start = ++r, w = r;
+                while (r < last) {
+                    if (data[r] == '"') {
+                        if (r + 1 < last && data[r + 1] == '"') {
+                            data[w++] = '"';
+                            r += 2;
+                            continue;
+                        }
+                        break;
+                    }
+                    if (data[r] == '\n') ++nextLine;
+                    data[w++] = data[r++];
+                }
+                if (r >= last) unterminated = true;
+                fields.emplace_back(data + start, w - start);
+                // Anything between the closing quote and the comma is dropped.
+                while (r < last && data[r] != ',') ++r;
+            } else {
+                size_t start = r;
+                while (r < last && data[r] != ',') ++r;
+                fields.push_back(trimView(string_view(data + start, r - start)));
+            }
+            if (r >= last) return;
+            ++r; // past the comma
+        }
+    }
+
+public:
+    explicit CsvReader(ByteSource& input, size_t blockSize = 1 << 16) : in(input), buf(blockSize, '\0') {
+        while (end < 3 && refill()) {} // a tiny block may need a few reads for the BOM
+        if (end >= 3 && buf.compare(0, 3, "\xEF\xBB\xBF") == 0) pos = 3; // UTF-8 BOM from spreadsheet exports
+    }
+
+    // Line the last record started on (1 based), for error messages.
+    size_t RecordLine() const { return recordLine; }
+    // The last record hit end of input inside a quoted field.
+    bool Unterminated() const { return unterminated; }
+    // Totals so far, for the load report.
+    uint64_t BytesRead() const { return bytesRead; }
+    size_t LinesRead() const { return nextLine - 1; }
+
+    // Next record's fields, valid until the next call. A blank line gives
+    // one empty field. False at end of input.
+    bool Next(vector<string_view>& fields) {
+        fields.clear();
+        unterminated = false;
+        recordLine = nextLine;
+        if (pos == end && !refill()) return false;
+
+        // Find the end of the physical line, reading more if needed.
+        size_t scanFrom = pos;
+        const char* nl;
+        while (!(nl = static_cast<const char*>(memchr(buf.data() + scanFrom, '\n', end - scanFrom)))) {
+            scanFrom = end - pos;
+            if (!refill()) break;
+        }
+        size_t lineEnd = nl ? static_cast<size_t>(nl - buf.data()) : end;
+
+        if (!memchr(buf.data() + pos, '"', lineEnd - pos)) {
+            splitCSV(string_view(buf.data() + pos, lineEnd - pos), fields);
+            pos = nl ? lineEnd + 1 : end;
+            ++nextLine;
+            return true;
+        }
+
+        // Quoted: the record ends at the first newline outside quotes. Same
+        // rule as splitQuoted: a '"' opens a quoted field only as the first
+        // non-blank character of a field (so 5" Floppy Disks is plain text),
+        // and right after a closing quote another '"' is an "" escape.
+        enum { FieldStart, Plain, Quoted, Closed } state = FieldStart;
+        size_t r = pos;
+        while (true) {
+            if (r == end) {
+                // refill may shift the buffer even when it finds nothing more.
+                size_t offset = r - pos;
+                bool more = refill();
+                r = pos + offset;
+                if (!more) break;
+                continue;
+            }
+            const char ch = buf[r];
+            if (state == Quoted) {
+                if (ch == '"') state = Closed;
+            } else if (ch == '\n') {
+                break;
+            } else if (ch == ',') {
+                state = FieldStart;
+            } else if (state == FieldStart) {
+                if (ch == '"') state = Quoted;
+                else if (ch != ' ' && ch != '\t') state = Plain;
+            } else if (state == Closed) {
+                state = ch == '"' ? Quoted : Plain; // after Plain, splitQuoted skips to the comma
+            }
+            ++r;
+        }
+        const size_t recordEnd = r;
+        splitQuoted(pos, recordEnd, fields);
+        pos = recordEnd < end ? recordEnd + 1 : end;
+        ++nextLine;
+        return true;
+    }
+};
+
+// ------------------------------ Data Model -----------------------------------
+
+// Course numbers are short codes, so I pack them inline instead of keeping a
+// std::string per course. There are two layouts, picked at build time with
+// the CourseKey alias below; both pack big endian, so comparing the integers
+// gives the same order as comparing the strings, with no heap pointer to
+// chase and nothing to allocate.
+
+// Any code up to 16 bytes, zero padded into two integers (hi then lo).
+// This is the default and takes odd catalogs as they come.
+struct GenericCourseKey {
+    static constexpr size_t MaxLength = 16;
+    static constexpr const char* Rejection = "longer than 16 characters";
+
+    uint64_t hi = 0;
+    uint64_t lo = 0;
+
+    // False (key left empty) if the code doesn't fit. With upper set, the
+    // code is uppercased while it's packed, so no uppercase copy is needed.
+    static bool FromString(string_view s, GenericCourseKey& key, bool upper = false) {
+        key = GenericCourseKey();
+        if (s.size() > MaxLength) return false;
+        for (size_t i = 0; i < s.size(); ++i) {
+            unsigned char ch = static_cast<unsigned char>(s[i]);
+            uint64_t byte = upper ? static_cast<unsigned char>(toupper(ch)) : ch;
+            if (i < 8) key.hi |= byte << (8 * (7 - i));
+            else       key.lo |= byte << (8 * (15 - i));
+        }
+        return true;
+    }
+
+    string str() const {
+        string s;
+        AppendTo(s);
+        return s;
+    }
+
+    bool empty() const { return hi == 0; }
+
+    // Appends the code to out without building a temporary string.
+    void AppendTo(string& out) const {
+        char bytes[MaxLength];
+        for (int i = 0; i < 8; ++i) {
+            bytes[i] = static_cast<char>(hi >> (8 * (7 - i)));
+            bytes[8 + i] = static_cast<char>(lo >> (8 * (7 - i)));
+        }
+        out.append(bytes, strnlen(bytes, MaxLength));
+    }
+
+    size_t Hash() const {
+        uint64_t h = hi * 0x9E3779B97F4A7C15ull ^ lo;
+        return static_cast<size_t>(h ^ (h >> 29));
+    }
+
+    friend bool operator==(const GenericCourseKey& a, const GenericCourseKey& b) { return a.hi == b.hi && a.lo == b.lo; }
+    friend bool operator!=(const GenericCourseKey& a, const GenericCourseKey& b) { return !(a == b); }
+    friend bool operator<(const GenericCourseKey& a, const GenericCourseKey& b) { return a.hi != b.hi ? a.hi < b.hi : a.lo < b.lo; }
+    friend bool operator>(const GenericCourseKey& a, const GenericCourseKey& b) { return b < a; }
+    friend ostream& operator<<(ostream& out, const GenericCourseKey& k) { return out << k.str(); }
+};
+
+// ABCU's own format, 4 letters and 3 digits (CSCI300), as one 32 bit number:
+// the letters in base 26, then the digits in base 10, plus one so 0 can mean
+// empty. Compares and hashes are one instruction each. Parsing is constexpr,
+// so the format is checked at compile time below. Codes in any other shape
+// are rejected at load, which is why this needs -DABCU_FIXED_COURSE_CODES.
+struct FixedCourseKey {
+    static constexpr size_t MaxLength = 7;
+    static constexpr const char* Rejection = "not 4 letters and 3 digits";
+
+    uint32_t code = 0;
+
+    static constexpr bool FromString(string_view s, FixedCourseKey& key, bool upper = false) {
+        key = FixedCourseKey();
+        if (s.size() != MaxLength) return false;
+        uint32_t packed = 0;
+        for (size_t i = 0; i < 4; ++i) {
+            char ch = s[i];
+            if (upper && ch >= 'a' && ch <= 'z') ch = static_cast<char>(ch - 'a' + 'A');
+            if (ch < 'A' || ch > 'Z') return false;
+            packed = packed * 26 + static_cast<uint32_t>(ch - 'A');
+        }
+        for (size_t i = 4; i < MaxLength; ++i) {
+            if (s[i] < '0' || s[i] > '9') return false;
+            packed = packed * 10 + static_cast<uint32_t>(s[i] - '0');
+        }
+        key.code = packed + 1;
+        return true;
+    }
+
+    static constexpr FixedCourseKey Parse(string_view s) {
+        FixedCourseKey key;
+        FromString(s, key, true);
+        return key;
+    }
+
+    string str() const {
+        string s;
+        AppendTo(s);
+        return s;
+    }
+
+    constexpr bool empty() const { return code == 0; }
+
+    void AppendTo(string& out) const {
+        if (empty()) return;
+        char text[MaxLength];
+        uint32_t packed = code - 1;
+        for (int i = 6; i >= 4; --i, packed /= 10) text[i] = static_cast<char>('0' + packed % 10);
+        for (int i = 3; i >= 0; --i, packed /= 26) text[i] = static_cast<char>('A' + packed % 26);
+        out.append(text, MaxLength);
+    }
+
+    size_t Hash() const { return code * size_t(0x9E3779B97F4A7C15ull); }
+
+    friend constexpr bool operator==(FixedCourseKey a, FixedCourseKey b) { return a.code == b.code; }
+    friend constexpr bool operator!=(FixedCourseKey a, FixedCourseKey b) { return a.code != b.code; }
+    friend constexpr bool operator<(FixedCourseKey a, FixedCourseKey b) { return a.code < b.code; }
+    friend constexpr bool operator>(FixedCourseKey a, FixedCourseKey b) { return a.code > b.code; }
+    friend ostream& operator<<(ostream& out, const FixedCourseKey& k) { return out << k.str(); }
+};
+
+static_assert(sizeof(FixedCourseKey) == 4, "fixed keys should pack into one 32 bit word");
+static_assert(FixedCourseKey::Parse("CSCI100") < FixedCourseKey::Parse("CSCI101") &&
+              FixedCourseKey::Parse("CSCI999") < FixedCourseKey::Parse("CSCJ000") &&
+              FixedCourseKey::Parse("csci300") == FixedCourseKey::Parse("CSCI300") &&
+              FixedCourseKey::Parse("ZZZZ999").code == 26u * 26 * 26 * 26 * 1000,
+              "fixed keys must sort like the strings they came from");
+static_assert(FixedCourseKey::Parse("CSC100").empty() && FixedCourseKey::Parse("CSCI10A").empty(),
+              "codes in any other shape must be rejected");
+
+#ifdef ABCU_FIXED_COURSE_CODES
+using CourseKey = FixedCourseKey;
+#else
+using CourseKey = GenericCourseKey;
+#endif
+
+// For unordered containers keyed by course number.
+struct CourseKeyHash {
+    size_t operator()(const CourseKey& k) const { return k.Hash(); }
+};
+
+struct Course {
+    CourseKey number;                // example CSCI200
+    string title;                    // example Intro to Algorithms
+    vector<CourseKey> prerequisites; // example {"CSCI100","MATH101"}
+};
+
+// -------------------------------- Ordered Map --------------------------------
+
+// Balanced ordered map, the engine under CourseBST and anything else that
+// needs sorted lookups (sections, instructors, rooms). It is an AA tree:
+// a red-black tree where only right links may be red, which keeps the
+// height under 2 log2 n for any insert order (a sorted file included) with
+// two tiny fix-ups, skew and split.
+// Nodes are a row in a few parallel vectors, allocated through Alloc, and
+// link to each other by index, so the map is a handful of growing blocks:
+// no per node allocation, no pointers to fix up when it grows, and Clear
+// keeps the capacity for the next load. Same idea as the CourseBST columns:
+// a lookup only walks keys and links, levels and values stay out of cache
+// until they're needed. Catalogs are rebuilt rather than edited, so there
+// is no erase.
+template <typename Key, typename Value, typename Compare = less<Key>,
+          typename Alloc = allocator<pair<const Key, Value>>>
+class OrderedMap {
+public:
+    static constexpr int Nil = -1;
+    static constexpr const char* Name = "AA tree";
+
+    // Height, leaves and total depth (root at depth 1), from Shape().
+    struct ShapeStats {
+        size_t height = 0;
+        size_t leaves = 0;
+        size_t depthSum = 0;
+        size_t fanout = 2;
+    };
+
+private:
+    struct Links {
+        int left = Nil;
+        int right = Nil;
+    };
+    template <typename T>
+    using Column = vector<T, typename allocator_traits<Alloc>::template rebind_alloc<T>>;
+
+    Column<Key> keys;
+    Column<Links> links;
+    Column<int> levels;  // leaves are level 1
+    Column<Value> values;
+    int root = Nil;
+    Compare less;
+
+    int levelOf(int t) const { return t == Nil ? 0 : levels[t]; }
+
+    // Left child on the same level: rotate right.
+    int skew(int t) {
+        int l = links[t].left;
+        if (l == Nil || levels[l] != levels[t]) return t;
+        links[t].left = links[l].right;
+        links[l].right = t;
+        return l;
+    }
+
+    // Two right children on the same level: rotate left, lift the middle.
+    int split(int t) {
+        int r = links[t].right;
+        if (r == Nil || levelOf(links[r].right) != levels[t]) return t;
+        links[t].right = links[r].left;
+        links[r].left = t;
+        ++levels[r];
+        return r;
+    }
+
+    // Recursion depth is the tree height, at most about 2 log2 n.
+    int insert(int t, const Key& key, const Value& value, int& at, bool& added) {
+        if (t == Nil) {
+            at = static_cast<int>(keys.size());
+            added = true;
+            keys.push_back(key);
+            links.push_back(Links{});
+            levels.push_back(1);
+            values.push_back(value);
+            return at;
+        }
+        if (less(key, keys[t])) {
+            const int child = insert(links[t].left, key, value, at, added);
+            links[t].left = child;
+        } else if (less(keys[t], key)) {
+            const int child = insert(links[t].right, key, value, at, added);
+            links[t].right = child;
+        } else {
+            at = t;
+            return t;
+        }
+        return split(skew(t));
+    }
+
+public:
+    explicit OrderedMap(const Compare& compare = Compare(), const Alloc& alloc = Alloc())
+        : keys(alloc), links(alloc), levels(alloc), values(alloc), less(compare) {}
+
+    void Clear() {
+        keys.clear();
+        links.clear();
+        levels.clear();
+        values.clear();
+        root = Nil;
+    }
+
+    void Reserve(size_t n) {
+        keys.reserve(n);
+        links.reserve(n);
+        levels.reserve(n);
+        values.reserve(n);
+    }
+    size_t Size() const { return keys.size(); }
+    bool Empty() const { return root == Nil; }
+
+    // Adds key -> value unless key is already there. Either way returns the
+    // stored value (valid until the next insert) and whether it was added.
+    pair<Value*, bool> Insert(const Key& key, const Value& value) {
+        int at = Nil;
+        bool added = false;
+        root = insert(root, key, value, at, added);
+        return {&values[at], added};
+    }
+
+    // Stored value for key or nullptr; comparisons gets the nodes visited.
+    const Value* Find(const Key& key, size_t& comparisons) const {
+        int cur = root;
+        while (cur != Nil) {
+            ++comparisons;
+            if (less(key, keys[cur])) cur = links[cur].left;
+            else if (less(keys[cur], key)) cur = links[cur].right;
+            else return &values[cur];
+        }
+        return nullptr;
+    }
+
+    const Value* Find(const Key& key) const {
+        size_t unused = 0;
+        return Find(key, unused);
+    }
+
+    // visit(key, value) for every entry in key order, with an explicit stack.
+    template <typename Visitor>
+    void ForEachInOrder(Visitor visit) const {
+        vector<int> stack;
+        int cur = root;
+        while (cur != Nil || !stack.empty()) {
+            while (cur != Nil) {
+                stack.push_back(cur);
+                cur = links[cur].left;
+            }
+            cur = stack.back();
+            stack.pop_back();
+            visit(keys[cur], values[cur]);
+            cur = links[cur].right;
+        }
+    }
+
+    ShapeStats Shape() const {
+        ShapeStats shape;
+        vector<pair<int, size_t>> stack;
+        if (root != Nil) stack.emplace_back(root, 1);
+        while (!stack.empty()) {
+            const int t = stack.back().first;
+            const size_t depth = stack.back().second;
+            stack.pop_back();
+            shape.depthSum += depth;
+            shape.height = max(shape.height, depth);
+            const Links& l = links[t];
+            if (l.left == Nil && l.right == Nil) ++shape.leaves;
+            if (l.left != Nil) stack.emplace_back(l.left, depth + 1);
+            if (l.right != Nil) stack.emplace_back(l.right, depth + 1);
+        }
+        return shape;
+    }
+
+    static constexpr size_t BytesPerNode = sizeof(Key) + sizeof(Links) + sizeof(int) + sizeof(Value);
+    size_t NodeBytes() const { return keys.size() * BytesPerNode; }
+    size_t NodeCapacity() const { return keys.capacity() * BytesPerNode; }
+};
+
+// --------------------------------- B+ Tree -----------------------------------
+
+// Same interface as OrderedMap, laid out for the cache instead: every node
+// starts on a cache line and fits in TargetNodeBytes (four lines), with its
+// keys stored inline. A lookup costs a miss or two per level and there are
+// only a handful of levels (12 entries per leaf and 13 children per inner
+// node with 16 byte keys, 31 and 32 with packed ones).
+// Values live only in the leaves, and leaves are linked left to right, so an
+// in order walk is a plain scan with no stack.
+// Nodes come from two vectors (inner and leaf) allocated through Alloc and
+// link by index, like OrderedMap. A leaf that overflows while appending at
+// the right edge stays full and only the new key moves over, so a sorted
+// load (and the rebuild in Compact) packs every leaf instead of leaving
+// them half empty. No erase, for the same reason as OrderedMap.
+template <typename Key, typename Value, typename Compare = less<Key>,
+          typename Alloc = allocator<pair<const Key, Value>>>
+class BPlusMap {
+public:
+    static constexpr int Nil = -1;
+    static constexpr const char* Name = "B+ tree";
+    static constexpr size_t CacheLine = 64;
+    static constexpr size_t TargetNodeBytes = 4 * CacheLine;
+
+    // Entries per leaf, and children per inner node.
+    static constexpr int LeafCapacity =
+        static_cast<int>((TargetNodeBytes - 2 * sizeof(int)) / (sizeof(Key) + sizeof(Value)));
+    static constexpr int Fanout = static_cast<int>((TargetNodeBytes - sizeof(int) + sizeof(Key)) / (sizeof(Key) + sizeof(int)));
+    static_assert(LeafCapacity >= 2 && Fanout >= 3, "key or value too big for a B+ tree node");
+
+    // Same fields as OrderedMap::ShapeStats. Every entry sits in a leaf, so
+    // each lookup visits height nodes.
+    struct ShapeStats {
+        size_t height = 0;
+        size_t leaves = 0;
+        size_t depthSum = 0;
+        size_t fanout = Fanout;
+    };
+
+private:
+    struct alignas(CacheLine) Leaf {
+        Key keys[LeafCapacity];
+        Value values[LeafCapacity];
+        int count = 0;
+        int next = Nil;  // right neighbour
+    };
+    // keys[i] is the smallest key under children[i + 1].
+    struct alignas(CacheLine) Inner {
+        Key keys[Fanout - 1];
+        int children[Fanout];
+        int count = 0;   // children in use
+    };
+    // Padding between the arrays (odd key / value alignments) could push a
+    // node onto a fifth line; the capacities above don't allow for it.
+    static_assert(sizeof(Leaf) <= TargetNodeBytes && sizeof(Inner) <= TargetNodeBytes,
+                  "B+ tree node spills past TargetNodeBytes");
+    template <typename T>
+    using Pool = vector<T, typename allocator_traits<Alloc>::template rebind_alloc<T>>;
+
+    Pool<Inner> inners;
+    Pool<Leaf> leaves;
+    int root = Nil;
+    int height = 0;      // levels; 1 means root is a leaf
+    size_t entries = 0;
+    Compare less;
+
+    // First i with !(keys[i] < key), and first i with key < keys[i].
+    int lowerBound(const Key* keys, int n, const Key& key, size_t& comparisons) const {
+        int lo = 0;
+        while (n > 0) {
+            const int half = n / 2;
+            ++comparisons;
+            if (less(keys[lo + half], key)) {
+                lo += half + 1;
+                n -= half + 1;
+            } else {
+                n = half;
+            }
+        }
+        return lo;
+    }
+
+    int upperBound(const Key* keys, int n, const Key& key, size_t& comparisons) const {
+        int lo = 0;
+        while (n > 0) {
+            const int half = n / 2;
+            ++comparisons;
+            if (!less(key, keys[lo + half])) {
+                lo += half + 1;
+                n -= half + 1;
+            } else {
+                n = half;
+            }
+        }
+        return lo;
+    }
+
+    // Where an insert ended up, and what a split hands to the parent.
+    struct Slot {
+        int leaf = Nil;
+        int index = 0;
+    };
+    struct Split {
+        Key separator{};
+        int right = Nil;
+    };
+
+    Split insertLeaf(int node, bool rightEdge, const Key& key, const Value& value, Slot& at, bool& added) {
+        size_t unused = 0;
+        Leaf* leaf = &leaves[node];
+        const int pos = lowerBound(leaf->keys, leaf->count, key, unused);
+        if (pos < leaf->count && !less(key, leaf->keys[pos])) {
+            at = Slot{node, pos};
+            return Split{};
+        }
+        added = true;
+        ++entries;
+        if (leaf->count < LeafCapacity) {
+            for (int i = leaf->count; i > pos; --i) {
+                leaf->keys[i] = leaf->keys[i - 1];
+                leaf->values[i] = leaf->values[i - 1];
+            }
+            leaf->keys[pos] = key;
+            leaf->values[pos] = value;
+            ++leaf->count;
+            at = Slot{node, pos};
+            return Split{};
+        }
+
+        // Full: lay out all LeafCapacity + 1 entries, then cut them in two.
+        Key keys[LeafCapacity + 1];
+        Value values[LeafCapacity + 1];
+        for (int i = 0, j = 0; i <= LeafCapacity; ++i) {
+            if (i == pos) {
+                keys[i] = key;
+                values[i] = value;
+            } else {
+                keys[i] = leaf->keys[j];
+                values[i] = leaf->values[j];
+                ++j;
+            }
+        }
+        const int keep = (rightEdge && pos == LeafCapacity) ? LeafCapacity : (LeafCapacity + 1) / 2;
+
+        const int right = static_cast<int>(leaves.size());
+        leaves.emplace_back();
+        leaf = &leaves[node];  // emplace_back may have moved it
+        Leaf& sibling = leaves[right];
+        leaf->count = keep;
+        copy(keys, keys + keep, leaf->keys);
+        copy(values, values + keep, leaf->values);
+        sibling.count = LeafCapacity + 1 - keep;
+        copy(keys + keep, keys + LeafCapacity + 1, sibling.keys);
+        copy(values + keep, values + LeafCapacity + 1, sibling.values);
+        sibling.next = leaf->next;
+        leaf->next = right;
+
+        at = pos < keep ? Slot{node, pos} : Slot{right, pos - keep};
+        return Split{sibling.keys[0], right};
+    }
+
+    Split insert(int node, int level, bool rightEdge, const Key& key, const Value& value, Slot& at, bool& added) {
+        if (level == 1) return insertLeaf(node, rightEdge, key, value, at, added);
+
+        size_t unused = 0;
+        const int pos = upperBound(inners[node].keys, inners[node].count - 1, key, unused);
+        const bool lastChild = pos == inners[node].count - 1;
+        const Split below = insert(inners[node].children[pos], level - 1, rightEdge && lastChild, key, value, at, added);
+        if (below.right == Nil) return Split{};
+
+        Inner* in = &inners[node];
+        if (in->count < Fanout) {
+            for (int i = in->count - 1; i > pos; --i) {
+                in->keys[i] = in->keys[i - 1];
+                in->children[i + 1] = in->children[i];
+            }
+            in->keys[pos] = below.separator;
+            in->children[pos + 1] = below.right;
+            ++in->count;
+            return Split{};
+        }
+
+        // Full: Fanout + 1 children and Fanout separators; the one between
+        // the two halves moves up to the parent.
+        Key keys[Fanout];
+        int children[Fanout + 1];
+        for (int i = 0, j = 0; i < Fanout; ++i) keys[i] = (i == pos) ? below.separator : in->keys[j++];
+        for (int i = 0, j = 0; i <= Fanout; ++i) children[i] = (i == pos + 1) ? below.right : in->children[j++];
+        const int keep = (rightEdge && lastChild) ? Fanout : (Fanout + 1) / 2;
+
+        const int right = static_cast<int>(inners.size());
+        inners.emplace_back();
+        in = &inners[node];
+        Inner& sibling = inners[right];
+        in->count = keep;
+        copy(keys, keys + keep - 1, in->keys);
+        copy(children, children + keep, in->children);
+        sibling.count = Fanout + 1 - keep;
+        copy(keys + keep, keys + Fanout, sibling.keys);
+        copy(children + keep, children + Fanout + 1, sibling.children);
+        return Split{keys[keep - 1], right};
+    }
+
+public:
+    explicit BPlusMap(const Compare& compare = Compare(), const Alloc& alloc = Alloc())
+        : inners(alloc), leaves(alloc), less(compare) {}
+
+    void Clear() {
+        inners.clear();
+        leaves.clear();
+        root = Nil;
+        height = 0;
+        entries = 0;
+    }
+
+    // Enough nodes for n sorted inserts (packed leaves); more if they aren't.
+    void Reserve(size_t n) {
+        const size_t leafCount = n / LeafCapacity + 1;
+        leaves.reserve(leafCount);
+        inners.reserve(leafCount / (Fanout - 1) + 1);
+    }
+    size_t Size() const { return entries; }
+    bool Empty() const { return entries == 0; }
+
+    // Adds key -> value unless key is already there. Either way returns the
+    // stored value (valid until the next insert) and whether it was added.
+    pair<Value*, bool> Insert(const Key& key, const Value& value) {
+        if (root == Nil) {
+            root = 0;
+            height = 1;
+            leaves.emplace_back();
+        }
+        Slot at;
+        bool added = false;
+        const Split split = insert(root, height, true, key, value, at, added);
+        if (split.right != Nil) {
+            Inner top;
+            top.count = 2;
+            top.keys[0] = split.separator;
+            top.children[0] = root;
+            top.children[1] = split.right;
+            root = static_cast<int>(inners.size());
+            inners.push_back(top);
+            ++height;
+        }
+        return {&leaves[at.leaf].values[at.index], added};
+    }
+
+    // Stored value for key or nullptr; comparisons gets the key comparisons.
+    const Value* Find(const Key& key, size_t& comparisons) const {
+        if (root == Nil) return nullptr;
+        int node = root;
+        for (int level = height; level > 1; --level) {
+            const Inner& in = inners[node];
+            node = in.children[upperBound(in.keys, in.count - 1, key, comparisons)];
+        }
+        const Leaf& leaf = leaves[node];
+        const int pos = lowerBound(leaf.keys, leaf.count, key, comparisons);
+        if (pos == leaf.count) return nullptr;
+        ++comparisons;
+        return less(key, leaf.keys[pos]) ? nullptr : &leaf.values[pos];
+    }
+
+    const Value* Find(const Key& key) const {
+        size_t unused = 0;
+        return Find(key, unused);
+    }
+
+    // visit(key, value) for every entry in key order. Splits only ever add
+    // right siblings, so the first leaf is always the leftmost one.
+    template <typename Visitor>
+    void ForEachInOrder(Visitor visit) const {
+        for (int node = root == Nil ? Nil : 0; node != Nil; node = leaves[node].next) {
+            const Leaf& leaf = leaves[node];
+            for (int i = 0; i < leaf.count; ++i) visit(leaf.keys[i], leaf.values[i]);
+        }
+    }
+
+    ShapeStats Shape() const {
+        ShapeStats shape;
+        shape.height = static_cast<size_t>(height);
+        shape.leaves = leaves.size();
+        shape.depthSum = entries * shape.height;
+        return shape;
+    }
+
+    size_t NodeBytes() const { return inners.size() * sizeof(Inner) + leaves.size() * sizeof(Leaf); }
+    size_t NodeCapacity() const { return inners.capacity() * sizeof(Inner) + leaves.capacity() * sizeof(Leaf); }
+};
+
+// ---------------------------- Binary Search Tree -----------------------------
+
+// The index under CourseBST. The B+ tree is the default; build with
+// -DABCU_AA_TREE_INDEX to get the binary AA tree back, e.g. to compare them.
+#ifdef ABCU_AA_TREE_INDEX
+template <typename Key>
+using CourseIndex = OrderedMap<Key, int>;
+#else
+template <typename Key>
+using CourseIndex = BPlusMap<Key, int>;
+#endif
+
+// Course storage is columnar: keys, titles and prerequisite ranges live in
+// separate arrays indexed by row, and the tree is an Index (BPlusMap or
+// OrderedMap) from course number to row. A search touches just the index's
+// nodes; a scan over titles
+// doesn't drag keys and vector headers through the cache with it.
+// Title text and prerequisite keys are bump allocated into two shared pools
+// and rows refer to them by offset and length, so a whole catalog costs a
+// handful of allocations instead of a few per course.
+// Key is the key policy (GenericCourseKey or FixedCourseKey): anything with
+// FromString, ==, < and AppendTo. The program uses the CourseBST alias.
+template <typename Key, typename Index = CourseIndex<Key>>
+class BasicCourseBST {
+public:
+    static constexpr int NotFound = -1;
+
+    // One course's prerequisites: a slice of the shared prerequisite column.
+    struct KeyRange {
+        const Key* first;
+        const Key* last;
+        const Key* begin() const { return first; }
+        const Key* end() const { return last; }
+        size_t size() const { return static_cast<size_t>(last - first); }
+        bool empty() const { return first == last; }
+    };
+
+    // Shape and footprint, from Stats(). Depth counts index nodes, so the
+    // root is at depth 1 and a search for a course at depth d visits d nodes.
+    struct TreeStats {
+        const char* index = Index::Name;
+        size_t fanout = 2;          // most children per index node
+        size_t nodes = 0;           // courses
+        size_t leaves = 0;
+        size_t height = 0;          // deepest node, 0 for an empty tree
+        size_t minimalHeight = 0;   // height of a full tree this size and fanout
+        double averageDepth = 0;    // mean nodes visited by a successful search
+
+        // Bytes in use (capacity in brackets when printed), per column group.
+        size_t keyBytes = 0, keyCapacity = 0;
+        size_t titleBytes = 0, titleCapacity = 0;   // pool + start/length columns
+        size_t prereqBytes = 0, prereqCapacity = 0; // pool + start/count columns
+        size_t linkBytes = 0, linkCapacity = 0;     // the index's nodes
+        size_t deadTitleBytes = 0;  // replaced slices still in the pools
+        size_t deadPrereqBytes = 0; //   (reclaimed by Compact)
+
+        size_t TotalBytes() const { return keyBytes + titleBytes + prereqBytes + linkBytes; }
+        size_t TotalCapacity() const { return keyCapacity + titleCapacity + prereqCapacity + linkCapacity; }
+        // Can't happen while the index stays balanced; kept as a sanity check.
+        bool Degenerate() const { return nodes >= 64 && height > 4 * minimalHeight; }
+    };
+
+private:
+    vector<Key> keys;
+    vector<uint32_t> titleStart;   // row's title is
+    vector<uint32_t> titleLength;  // titlePool[start .. start + length)
+    vector<char> titlePool;
+    vector<uint32_t> prereqStart;  // row's prerequisites are
+    vector<uint32_t> prereqCount;  // prereqKeys[start .. start + count)
+    vector<Key> prereqKeys;
+
+    Index index;                   // course number -> row
+
+    // Same reuse-or-append rule as setPrereqs below.
+    void setTitle(int row, string_view title) {
+        if (title.size() > titleLength[row]) {
+            titleStart[row] = static_cast<uint32_t>(titlePool.size());
+            titlePool.insert(titlePool.end(), title.begin(), title.end());
+        } else {
+            copy(title.begin(), title.end(), titlePool.begin() + titleStart[row]);
+        }
+        titleLength[row] = static_cast<uint32_t>(title.size());
+    }
+
+    void setPrereqs(int row, KeyRange prereqs) {
+        // Reuse the old slice when it's big enough, otherwise append a new one
+        // (the old slice becomes garbage until the next Compact).
+        if (prereqs.size() > prereqCount[row]) {
+            prereqStart[row] = static_cast<uint32_t>(prereqKeys.size());
+            prereqKeys.insert(prereqKeys.end(), prereqs.begin(), prereqs.end());
+        } else {
+            copy(prereqs.begin(), prereqs.end(), prereqKeys.begin() + prereqStart[row]);
+        }
+        prereqCount[row] = static_cast<uint32_t>(prereqs.size());
+    }
+
+public:
+    void Clear() {
+        keys.clear();
+        titleStart.clear();
+        titleLength.clear();
+        titlePool.clear();
+        prereqStart.clear();
+        prereqCount.clear();
+        prereqKeys.clear();
+        index.Clear();
+    }
+
+    // Build a course in place from views: the title and prerequisites are
+    // copied once, straight into the pools, with no Course built in between.
+    // The views may point into any caller buffer (the loader reuses one).
+    void Emplace(const Key& number, string_view title, KeyRange prereqs) {
+        const int row = static_cast<int>(keys.size());
+        pair<int*, bool> slot = index.Insert(number, row);
+        if (!slot.second) {
+            // If duplicate key appears, I’ll update the title and prereqs (safer than ignoring).
+            setTitle(*slot.first, title);
+            setPrereqs(*slot.first, prereqs);
+            return;
+        }
+
+        keys.push_back(number);
+        titleStart.push_back(0);
+        titleLength.push_back(0);
+        setTitle(row, title);
+        prereqStart.push_back(0);
+        prereqCount.push_back(0);
+        setPrereqs(row, prereqs);
+    }
+
+    void Insert(const Course& c) {
+        const CourseKey* first = c.prerequisites.data();
+        Emplace(c.number, c.title, KeyRange{first, first + c.prerequisites.size()});
+    }
+
+    // Row of the course, or NotFound. comparisons gets the number of nodes
+    // visited (for the query metrics); the overloads without it compile
+    // the counting away.
+    int Search(const Key& number, size_t& comparisons) const {
+        const int* row = index.Find(number, comparisons);
+        return row ? *row : NotFound;
+    }
+
+    int Search(const Key& number) const {
+        size_t unused = 0;
+        return Search(number, unused);
+    }
+
+    // Case insensitive lookup straight from user or file text.
+    int Search(string_view number, size_t& comparisons) const {
+        Key key;
+        if (!Key::FromString(number, key, true)) return NotFound;
+        return Search(key, comparisons);
+    }
+
+    int Search(string_view number) const {
+        size_t unused = 0;
+        return Search(number, unused);
+    }
+
+    size_t Size() const { return keys.size(); }
+    bool Empty() const { return index.Empty(); }
+
+    const Key& Number(int row) const { return keys[row]; }
+    string_view Title(int row) const { return string_view(titlePool.data() + titleStart[row], titleLength[row]); }
+    KeyRange Prerequisites(int row) const {
+        const Key* first = prereqKeys.data() + prereqStart[row];
+        return KeyRange{first, first + prereqCount[row]};
+    }
+
+    // Visit every row in sorted order.
+    template <typename Visitor>
+    void ForEachInOrder(Visitor visit) const {
+        index.ForEachInOrder([&visit](const Key&, int row) { visit(row); });
+    }
+
+    void PrintInOrder() const {
+        ForEachInOrder([this](int row) { cout << keys[row] << ", " << Title(row) << '\n'; });
+    }
+
+    // The same text as PrintInOrder, rendered into out in one pass.
+    void RenderInOrder(string& out) const {
+        out.clear();
+        out.reserve(titlePool.size() + keys.size() * (Key::MaxLength + 3));
+        ForEachInOrder([&](int row) {
+            keys[row].AppendTo(out);
+            out += ", ";
+            out.append(titlePool.data() + titleStart[row], titleLength[row]);
+            out += '\n';
+        });
+    }
+
+    // The index's shape (one pass over an AA tree, free for the B+ tree)
+    // plus the column sizes, so it's cheap enough to run after every load.
+    TreeStats Stats() const {
+        TreeStats st;
+        const typename Index::ShapeStats shape = index.Shape();
+        st.fanout = shape.fanout;
+        st.nodes = keys.size();
+        for (size_t n = st.nodes; n > 0; n /= st.fanout) ++st.minimalHeight;
+        st.height = shape.height;
+        st.leaves = shape.leaves;
+        if (st.nodes > 0) st.averageDepth = static_cast<double>(shape.depthSum) / st.nodes;
+
+        auto used = [](const auto& column) { return column.size() * sizeof(column[0]); };
+        auto reserved = [](const auto& column) { return column.capacity() * sizeof(column[0]); };
+        st.keyBytes = used(keys);
+        st.keyCapacity = reserved(keys);
+        st.titleBytes = used(titlePool) + used(titleStart) + used(titleLength);
+        st.titleCapacity = reserved(titlePool) + reserved(titleStart) + reserved(titleLength);
+        st.prereqBytes = used(prereqKeys) + used(prereqStart) + used(prereqCount);
+        st.prereqCapacity = reserved(prereqKeys) + reserved(prereqStart) + reserved(prereqCount);
+        st.linkBytes = index.NodeBytes();
+        st.linkCapacity = index.NodeCapacity();
+
+        size_t liveTitle = 0, livePrereqs = 0;
+        for (size_t row = 0; row < st.nodes; ++row) {
+            liveTitle += titleLength[row];
+            livePrereqs += prereqCount[row];
+        }
+        st.deadTitleBytes = titlePool.size() - liveTitle;
+        st.deadPrereqBytes = (prereqKeys.size() - livePrereqs) * sizeof(Key);
+        return st;
+    }
+
+    // Renumber rows into sorted order, repack both pools and rebuild the
+    // index. Afterwards row i is the i-th course by number, so sorted scans
+    // walk every column front to back, and the index is rebuilt from sorted
+    // keys, so nearby keys share cache lines (and B+ tree leaves come out
+    // full). The loader calls this once after the last insert.
+    void Compact() {
+        const size_t n = keys.size();
+        vector<int> order;
+        order.reserve(n);
+        ForEachInOrder([&order](int row) { order.push_back(row); });
+
+        vector<Key> k(n), pk;
+        vector<char> tp;
+        vector<uint32_t> ts(n), tl(n), ps(n), pc(n);
+        tp.reserve(titlePool.size());
+        pk.reserve(prereqKeys.size());
+        for (size_t i = 0; i < n; ++i) {
+            const int old = order[i];
+            k[i] = keys[old];
+            ts[i] = static_cast<uint32_t>(tp.size());
+            tl[i] = titleLength[old];
+            tp.insert(tp.end(), titlePool.begin() + titleStart[old],
+                      titlePool.begin() + titleStart[old] + titleLength[old]);
+            ps[i] = static_cast<uint32_t>(pk.size());
+            pc[i] = prereqCount[old];
+            pk.insert(pk.end(), prereqKeys.begin() + prereqStart[old],
+                      prereqKeys.begin() + prereqStart[old] + prereqCount[old]);
+        }
+        keys.swap(k);
+        titleStart.swap(ts);
+        titleLength.swap(tl);
+        titlePool.swap(tp);
+        prereqStart.swap(ps);
+        prereqCount.swap(pc);
+        prereqKeys.swap(pk);
+
+        Index rebuilt; // sized exactly, dropping the growth slack
+        rebuilt.Reserve(n);
+        for (size_t i = 0; i < n; ++i) rebuilt.Insert(keys[i], static_cast<int>(i));
+        index = move(rebuilt);
+    }
+};
+
+using CourseBST = BasicCourseBST<CourseKey>;
+
+// ---------------------------- Prerequisite Graph -----------------------------
+
+// Prerequisite edges resolved once over course ids, stored CSR style: the
+// prereqs of course i are edges[edgeStart[i] .. edgeStart[i + 1]). A course
+// id is its row in the compacted CourseBST, which is also its sorted position.
+// The reverse edges (courses that list i as a prerequisite) are kept the
+// same way in dependents, and missingCount[i] counts prereqs of i that
+// aren't in the catalog at all.
+struct CatalogGraph {
+    vector<size_t> edgeStart;
+    vector<int> edges;
+    vector<size_t> dependentStart;
+    vector<int> dependents;
+    vector<int> missingCount;
+
+    size_t Size() const { return missingCount.size(); }
+};
+
+// Build the graph from a compacted tree and report prerequisites that aren't
+// in the catalog. Rows are visited in storage order, so this is one linear
+// pass over the prerequisite column plus a search per prerequisite.
+static void BuildCatalogGraph(const CourseBST& bst, CatalogGraph& g, vector<string>& errors) {
+    g.edgeStart.clear();
+    g.edges.clear();
+    g.dependentStart.clear();
+    g.dependents.clear();
+    g.missingCount.clear();
+
+    const size_t n = bst.Size();
+    g.edgeStart.reserve(n + 1);
+    g.missingCount.assign(n, 0);
+    for (size_t i = 0; i < n; ++i) {
+        g.edgeStart.push_back(g.edges.size());
+        for (const CourseKey& p : bst.Prerequisites(static_cast<int>(i))) {
+            int id = bst.Search(p);
+            if (id == CourseBST::NotFound) {
+                errors.push_back("Course '" + bst.Number(static_cast<int>(i)).str() +
+                                 "' lists missing prerequisite '" + p.str() + "'.");
+                ++g.missingCount[i];
+            } else {
+                g.edges.push_back(id);
+            }
+        }
+    }
+    g.edgeStart.push_back(g.edges.size());
+
+    // Reverse edges with a counting sort, still linear.
+    g.dependentStart.assign(n + 1, 0);
+    for (int p : g.edges) ++g.dependentStart[p + 1];
+    for (size_t i = 0; i < n; ++i) g.dependentStart[i + 1] += g.dependentStart[i];
+    g.dependents.resize(g.edges.size());
+    vector<size_t> fill(g.dependentStart.begin(), g.dependentStart.end() - 1);
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t k = g.edgeStart[i]; k < g.edgeStart[i + 1]; ++k) {
+            g.dependents[fill[g.edges[k]]++] = static_cast<int>(i);
+        }
+    }
+}
+
+// Tarjan's strongly connected components, written iteratively so long
+// prerequisite chains can't overflow the stack. O(V + E).
+// Returns every component that contains a cycle: more than one course, or a
+// single course that lists itself.
+static vector<vector<int>> FindPrerequisiteCycles(const CatalogGraph& g) {
+    const int n = static_cast<int>(g.Size());
+    const int unvisited = -1;
+
+    vector<int> index(n, unvisited), low(n, 0);
+    vector<char> onStack(n, 0);
+    vector<int> sccStack;
+    vector<pair<int, size_t>> callStack; // (node, next edge to look at)
+    vector<vector<int>> cycles;
+    int counter = 0;
+
+    for (int start = 0; start < n; ++start) {
+        if (index[start] != unvisited) continue;
+
+        callStack.emplace_back(start, g.edgeStart[start]);
+        index[start] = low[start] = counter++;
+        sccStack.push_back(start);
+        onStack[start] = 1;
+
+        while (!callStack.empty()) {
+            int v = callStack.back().first;
+            size_t& e = callStack.back().second;
+
+            if (e < g.edgeStart[v + 1]) {
+                int w = g.edges[e++];
+                if (index[w] == unvisited) {
+                    index[w] = low[w] = counter++;
+                    sccStack.push_back(w);
+                    onStack[w] = 1;
+                    callStack.emplace_back(w, g.edgeStart[w]);
+                } else if (onStack[w]) {
+                    low[v] = min(low[v], index[w]);
+                }
+                continue;
+            }
+
+            // All edges of v done: close its component if v is the root.
+            // Almost every component is a lone course, so that case is
+            // settled in place; only real cycles get a vector.
+            if (low[v] == index[v]) {
+                if (sccStack.back() == v) {
+                    sccStack.pop_back();
+                    onStack[v] = 0;
+                    for (size_t k = g.edgeStart[v]; k < g.edgeStart[v + 1]; ++k) {
+                        if (g.edges[k] == v) {
+                            cycles.push_back({v});
+                            break;
+                        }
+                    }
+                } else {
+                    vector<int> scc;
+                    int w;
+                    do {
+                        w = sccStack.back();
+                        sccStack.pop_back();
+                        onStack[w] = 0;
+                        scc.push_back(w);
+                    } while (w != v);
+                    cycles.push_back(move(scc));
+                }
+            }
+
+            callStack.pop_back();
+            if (!callStack.empty()) {
+                int parent = callStack.back().first;
+                low[parent] = min(low[parent], low[v]);
+            }
+        }
+    }
+    return cycles;
+}
+
+// Turn a cyclic component into a readable message. I BFS inside the component
+// from its smallest course back to itself, so the path shown is a real cycle
+// (each course requires the next) and the cost stays linear in the component.
+// parent is scratch shared by every call in a validation pass: g.Size()
+// entries, all -2 (not in this component). Only the component's entries are
+// touched, and they're put back to -2 before returning, so thousands of small
+// cycles don't each pay for a whole catalog sized array.
+static string DescribeCycle(const CourseBST& bst, const CatalogGraph& g, vector<int> scc, vector<int>& parent) {
+    sort(scc.begin(), scc.end());
+    const int start = scc.front();
+
+    for (int v : scc) parent[v] = -1; // -1 = in this component, unseen
+
+    vector<int> queue{start};
+    int closing = -1; // node whose edge leads back to start
+    parent[start] = start;
+    for (size_t head = 0; head < queue.size() && closing < 0; ++head) {
+        int v = queue[head];
+        for (size_t k = g.edgeStart[v]; k < g.edgeStart[v + 1]; ++k) {
+            int w = g.edges[k];
+            if (w == start) { closing = v; break; }
+            if (parent[w] == -1) {
+                parent[w] = v;
+                queue.push_back(w);
+            }
+        }
+    }
+
+    vector<int> path;
+    for (int v = closing; v != start; v = parent[v]) path.push_back(v);
+    path.push_back(start);
+    reverse(path.begin(), path.end());
+    for (int v : scc) parent[v] = -2;
+
+    string msg = "Prerequisite cycle: ";
+    for (int v : path) msg += bst.Number(v).str() + " -> ";
+    msg += bst.Number(start).str() + ".";
+    if (scc.size() > path.size()) {
+        msg += " (" + to_string(scc.size()) + " courses are mutually dependent:";
+        for (int v : scc) msg += " " + bst.Number(v).str();
+        msg += ")";
+    }
+    return msg;
+}
+
+// ----------------------------- Semester Planner ------------------------------
+
+struct SemesterPlan {
+    vector<vector<int>> terms;  // course ids per term, in pick order
+    vector<int> unschedulable;  // blocked by a cycle or a missing prerequisite
+};
+
+// Layered Kahn's algorithm over the targets plus everything they transitively
+// require. A course becomes available the term after its last prerequisite,
+// and each term takes up to perTerm available courses by priority:
+//   1) longest chain of plan courses that still depend on it (critical path),
+//   2) more dependents in the plan (unlocks more next term),
+//   3) course number, so plans are deterministic.
+// Cost is O((V + E) log V) over the plan's courses only.
+static SemesterPlan PlanSemesters(const CatalogGraph& g, const vector<int>& targets, size_t perTerm) {
+    const size_t n = g.Size();
+    SemesterPlan plan;
+
+    // Closure of the targets via iterative DFS, recording post order
+    // (prerequisites finish before the courses that need them).
+    vector<char> inPlan(n, 0);
+    vector<int> postOrder;
+    vector<pair<int, size_t>> stack;
+    for (int t : targets) {
+        if (inPlan[t]) continue;
+        inPlan[t] = 1;
+        stack.emplace_back(t, g.edgeStart[t]);
+        while (!stack.empty()) {
+            int v = stack.back().first;
+            size_t& e = stack.back().second;
+            if (e < g.edgeStart[v + 1]) {
+                int w = g.edges[e++];
+                if (!inPlan[w]) {
+                    inPlan[w] = 1;
+                    stack.emplace_back(w, g.edgeStart[w]);
+                }
+                continue;
+            }
+            postOrder.push_back(v);
+            stack.pop_back();
+        }
+    }
+
+    // Critical path length, filled in reverse post order so dependents come first.
+    vector<int> height(n, 0), fanOut(n, 0), inDegree(n, 0);
+    for (auto it = postOrder.rbegin(); it != postOrder.rend(); ++it) {
+        int v = *it;
+        int best = 0;
+        for (size_t k = g.dependentStart[v]; k < g.dependentStart[v + 1]; ++k) {
+            int d = g.dependents[k];
+            if (!inPlan[d]) continue;
+            best = max(best, height[d]);
+            ++fanOut[v];
+        }
+        height[v] = best + 1;
+        // Missing prerequisites can never be satisfied, so they keep the count above zero.
+        inDegree[v] = static_cast<int>(g.edgeStart[v + 1] - g.edgeStart[v]) + g.missingCount[v];
+    }
+
+    // Max-heap on (height, fanOut, -id).
+    auto lower = [&](int a, int b) {
+        if (height[a] != height[b]) return height[a] < height[b];
+        if (fanOut[a] != fanOut[b]) return fanOut[a] < fanOut[b];
+        return a > b;
+    };
+    vector<int> ready;
+    for (int v : postOrder) {
+        if (inDegree[v] == 0) ready.push_back(v);
+    }
+    make_heap(ready.begin(), ready.end(), lower);
+
+    size_t scheduled = 0;
+    while (!ready.empty()) {
+        vector<int> term;
+        while (!ready.empty() && term.size() < perTerm) {
+            pop_heap(ready.begin(), ready.end(), lower);
+            term.push_back(ready.back());
+            ready.pop_back();
+        }
+        // Unlock dependents only after the term is chosen, so nothing is taken
+        // in the same term as its prerequisite.
+        for (int v : term) {
+            for (size_t k = g.dependentStart[v]; k < g.dependentStart[v + 1]; ++k) {
+                int d = g.dependents[k];
+                if (inPlan[d] && --inDegree[d] == 0) {
+                    ready.push_back(d);
+                    push_heap(ready.begin(), ready.end(), lower);
+                }
+            }
+        }
+        scheduled += term.size();
+        plan.terms.push_back(move(term));
+    }
+
+    if (scheduled < postOrder.size()) {
+        for (int v : postOrder) {
+            if (inDegree[v] > 0) plan.unschedulable.push_back(v);
+        }
+        sort(plan.unschedulable.begin(), plan.unschedulable.end());
+    }
+    return plan;
+}
+
+// ---------------------------- Eligibility Engine -----------------------------
+
+// A student's completed courses as a dense bitset over course ids (bit i of
+// word i / 64 is course i in the graph).
+using CourseBitset = vector<uint64_t>;
+
+// Answers "which courses can this student take next?" Each course's
+// prerequisite list is grouped by bitset word into (word, mask) pairs, so a
+// check is one AND + compare per word touched instead of one lookup per prereq.
+class EligibilityEngine {
+private:
+    size_t words = 0;
+    vector<uint32_t> reqStart;  // pairs of course i: [reqStart[i], reqStart[i + 1])
+    vector<uint32_t> reqWord;
+    vector<uint64_t> reqMask;
+    vector<uint64_t> open;      // courses with no prerequisites at all
+    vector<uint64_t> closed;    // courses with a missing prerequisite: never eligible
+    vector<uint64_t> valid;     // bits that are real course ids (last word is partial)
+
+public:
+    void Build(const CatalogGraph& g) {
+        const size_t n = g.Size();
+        words = (n + 63) / 64;
+        reqStart.assign(1, 0);
+        reqStart.reserve(n + 1);
+        reqWord.clear();
+        reqMask.clear();
+        open.assign(words, 0);
+        closed.assign(words, 0);
+        valid.assign(words, ~0ULL);
+        if (n % 64) valid.back() = (1ULL << (n % 64)) - 1;
+
+        vector<int> prereqs;
+        for (size_t i = 0; i < n; ++i) {
+            const uint64_t bit = 1ULL << (i % 64);
+            if (g.missingCount[i] > 0) closed[i / 64] |= bit;
+
+            prereqs.assign(g.edges.begin() + g.edgeStart[i], g.edges.begin() + g.edgeStart[i + 1]);
+            if (prereqs.empty() && g.missingCount[i] == 0) open[i / 64] |= bit;
+
+            sort(prereqs.begin(), prereqs.end());
+            for (int p : prereqs) {
+                const uint32_t w = static_cast<uint32_t>(p / 64);
+                if (reqWord.size() == reqStart.back() || reqWord.back() != w) {
+                    reqWord.push_back(w);
+                    reqMask.push_back(0);
+                }
+                reqMask.back() |= 1ULL << (p % 64);
+            }
+            reqStart.push_back(static_cast<uint32_t>(reqWord.size()));
+        }
+    }
+
+    size_t Words() const { return words; }
+
+    CourseBitset MakeCompleted(const vector<int>& ids) const {
+        CourseBitset done(words, 0);
+        for (int id : ids) done[id / 64] |= 1ULL << (id % 64);
+        return done;
+    }
+
+    bool PrereqsMet(const CourseBitset& done, size_t id) const {
+        for (uint32_t k = reqStart[id]; k < reqStart[id + 1]; ++k) {
+            if ((done[reqWord[k]] & reqMask[k]) != reqMask[k]) return false;
+        }
+        return true;
+    }
+
+    // Every course not yet completed whose prerequisites are all completed,
+    // in course number order. Works a word (64 courses) at a time: completed,
+    // blocked and prerequisite-free courses are settled with bit ops, and
+    // only the remaining candidates walk their (word, mask) pairs.
+    void Eligible(const CourseBitset& done, vector<int>& out) const {
+        collect(done, out, true);
+    }
+
+    // Same, minus the courses with no prerequisites: everyone could always
+    // take those, so they're not news. This is what the cohort report lists,
+    // and on a big catalog it's most of the output without the mask.
+    void NewlyEligible(const CourseBitset& done, vector<int>& out) const {
+        collect(done, out, false);
+    }
+
+private:
+    void collect(const CourseBitset& done, vector<int>& out, bool withOpen) const {
+        out.clear();
+        for (size_t w = 0; w < words; ++w) {
+            uint64_t candidates = valid[w] & ~done[w] & ~closed[w];
+            uint64_t result = withOpen ? candidates & open[w] : 0;
+            uint64_t toCheck = candidates & ~open[w];
+            while (toCheck) {
+                const int b = LowestBit(toCheck);
+                toCheck &= toCheck - 1;
+                if (PrereqsMet(done, w * 64 + b)) result |= 1ULL << b;
+            }
+            while (result) {
+                const int b = LowestBit(result);
+                result &= result - 1;
+                out.push_back(static_cast<int>(w * 64 + b));
+            }
+        }
+    }
+};
+
+// ----------------------------- Cohort Eligibility ----------------------------
+
+struct StudentRecord {
+    string id;
+    vector<int> completed; // course ids in the catalog graph
+};
+
+// Student file format, one student per line: StudentID,COURSE1,COURSE2,...
+// Unknown course numbers are reported and skipped; the student is still evaluated.
+[[maybe_unused]]
+static bool LoadStudentsFromFile(const string& filePath, const CourseBST& bst,
+                                 vector<StudentRecord>& students, vector<string>& errors) {
+    string openError;
+    unique_ptr<ByteSource> source = OpenInputSource(filePath, openError);
+    if (!source) {
+        errors.push_back(openError);
+        return false;
+    }
+
+    students.clear();
+    CsvReader reader(*source);
+    vector<string_view> tokens;
+    while (reader.Next(tokens)) {
+        const size_t lineNumber = reader.RecordLine();
+        if (tokens.size() == 1 && tokens[0].empty()) continue; // blank line
+
+        if (tokens[0].empty()) {
+            errors.push_back("Line " + to_string(lineNumber) + ": missing student id.");
+            continue;
+        }
+
+        StudentRecord s;
+        s.id = string(tokens[0]);
+        for (size_t i = 1; i < tokens.size(); ++i) {
+            if (tokens[i].empty()) continue;
+            int id = bst.Search(tokens[i]);
+            if (id == CourseBST::NotFound) {
+                errors.push_back("Line " + to_string(lineNumber) + ": student '" + s.id +
+                                 "' lists unknown course '" + upperCopy(tokens[i]) + "'.");
+                continue;
+            }
+            s.completed.push_back(id);
+        }
+        students.push_back(move(s));
+    }
+    if (!source->Error().empty()) {
+        errors.push_back("Error: reading '" + filePath + "' failed (" + source->Error() + ").");
+        return false;
+    }
+    return true;
+}
+
+// Evaluate every student against the shared engine: the courses each one has
+// newly unlocked (see NewlyEligible). The engine and graph are only read,
+// so each worker takes a contiguous slice of students and writes to its own
+// slots in results; no locking needed.
+[[maybe_unused]]
+static vector<vector<int>> EvaluateCohort(const EligibilityEngine& engine, const vector<StudentRecord>& students) {
+    vector<vector<int>> results(students.size());
+
+    auto work = [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            engine.NewlyEligible(engine.MakeCompleted(students[i].completed), results[i]);
+        }
+    };
+
+    // Small cohorts aren't worth the thread start up cost.
+    const size_t minPerThread = 256;
+    size_t threads = max<size_t>(1, thread::hardware_concurrency());
+    threads = min(threads, max<size_t>(1, students.size() / minPerThread));
+
+    if (threads == 1) {
+        work(0, students.size());
+        return results;
+    }
+
+    vector<thread> pool;
+    const size_t chunk = (students.size() + threads - 1) / threads;
+    for (size_t begin = 0; begin < students.size(); begin += chunk) {
+        pool.emplace_back(work, begin, min(begin + chunk, students.size()));
+    }
+    for (thread& t : pool) t.join();
+    return results;
+}
+
+// One line per student, in file order: StudentID: COURSE, COURSE, ...
+[[maybe_unused]]
+static void WriteCohortResults(ostream& out, const CourseBST& bst,
+                               const vector<StudentRecord>& students, const vector<vector<int>>& results) {
+    for (size_t i = 0; i < students.size(); ++i) {
+        out << students[i].id << ':';
+        if (results[i].empty()) out << " (none)";
+        for (size_t k = 0; k < results[i].size(); ++k) {
+            out << (k ? ", " : " ") << bst.Number(results[i][k]);
+        }
+        out << '\n';
+    }
+}
+
+// -------------------------------- Fuzzy Search -------------------------------
+
+// Plain Levenshtein distance, two rows. The rows are the caller's, so
+// scoring a shortlist doesn't allocate once they have grown.
+static size_t EditDistance(string_view a, string_view b, vector<size_t>& prev, vector<size_t>& cur) {
+    prev.resize(b.size() + 1);
+    cur.resize(b.size() + 1);
+    for (size_t j = 0; j <= b.size(); ++j) prev[j] = j;
+    for (size_t i = 1; i <= a.size(); ++i) {
+        cur[0] = i;
+        for (size_t j = 1; j <= b.size(); ++j) {
+            size_t sub = prev[j - 1] + (a[i - 1] == b[j - 1] ? 0 : 1);
+            cur[j] = min(sub, min(prev[j], cur[j - 1]) + 1);
+        }
+        swap(prev, cur);
+    }
+    return prev[b.size()];
+}
+
+// Edit distance from the query to the best matching substring of text, so a
+// partial title like "ALGORITHMS" scores 0 against "Introduction to Algorithms".
+// The query is already uppercase; text is folded per character, so titles are
+// scored straight from the tree's title pool.
+static size_t SubstringEditDistance(string_view query, string_view text, vector<size_t>& prev, vector<size_t>& cur) {
+    prev.assign(text.size() + 1, 0);
+    cur.resize(text.size() + 1);
+    for (size_t i = 1; i <= query.size(); ++i) {
+        cur[0] = i;
+        for (size_t j = 1; j <= text.size(); ++j) {
+            char upper = static_cast<char>(toupper(static_cast<unsigned char>(text[j - 1])));
+            size_t sub = prev[j - 1] + (query[i - 1] == upper ? 0 : 1);
+            cur[j] = min(sub, min(prev[j], cur[j - 1]) + 1);
+        }
+        swap(prev, cur);
+    }
+    return *min_element(prev.begin(), prev.end());
+}
+
+// Trigram index over course numbers and titles, built once per load.
+// Postings are one flat byte array in the same offset layout as CatalogGraph:
+// the courses containing gram g are postings[gramStart[g] .. gramStart[g + 1]),
+// ascending ids stored as gaps in 7 bit varints (a common trigram's gaps fit in
+// one byte, a quarter of an int). Numbers and titles are read from the tree's
+// columns, not copied.
+// A query walks its rarest trigram lists first and stops after PostingBudget
+// bytes of them (a trigram in tens of thousands of courses doesn't narrow the
+// search), and only the best few courses pay for an edit distance, so a
+// suggestion stays well under a millisecond even at a million courses.
+// The per query counters are kept between calls: one Suggest at a time.
+class FuzzyIndex {
+private:
+    // Grams are three 6 bit symbols, case folded: space 0, A-Z 1-26, 0-9
+    // 27-36, and any other byte shares one of the rest. That makes 2^18
+    // possible grams, few enough to index gramStart directly.
+    static constexpr uint32_t GramBits = 18;
+    static constexpr uint32_t GramCount = 1u << GramBits;
+    static constexpr size_t PostingBudget = 1 << 16;
+
+    vector<size_t> gramStart;        // GramCount + 1 offsets into postings
+    vector<uint8_t> postings;
+
+    // Query scratch, sized by Build and left zeroed after each Suggest.
+    mutable vector<uint16_t> shared; // by course id: trigrams shared with the query
+    mutable vector<int> touched;
+    mutable vector<uint32_t> queryGrams;
+    mutable vector<size_t> histogram;     // courses by shared count
+    mutable vector<pair<size_t, int>> ranked; // (distance, id)
+    mutable vector<size_t> prevRow, curRow;
+    mutable string number;
+
+    static uint32_t Symbol(char ch) {
+        unsigned char u = static_cast<unsigned char>(ch);
+        if (u >= 'A' && u <= 'Z') return 1 + (u - 'A');
+        if (u >= 'a' && u <= 'z') return 1 + (u - 'a');
+        if (u >= '0' && u <= '9') return 27 + (u - '0');
+        if (u == ' ') return 0;
+        return 37 + u % 27;
+    }
+
+    // Calls visit(gram) for each trigram of text padded as "  " + text + " ",
+    // so short strings and word starts still produce trigrams. Repeats included.
+    template <typename Visit>
+    static void ForEachGram(string_view text, Visit visit) {
+        uint32_t gram = 0; // the two leading spaces
+        for (char ch : text) {
+            gram = ((gram << 6) | Symbol(ch)) & (GramCount - 1);
+            visit(gram);
+        }
+        visit((gram << 6) & (GramCount - 1));
+    }
+
+    static size_t VarintBytes(uint32_t value) {
+        size_t bytes = 1;
+        while (value >= 0x80) {
+            value >>= 7;
+            ++bytes;
+        }
+        return bytes;
+    }
+
+public:
+    // Two passes over the columns, a counting sort: size each gram's list,
+    // then append each course to its lists. Courses go in id order, so every
+    // list comes out sorted with no sort at all, and the gap from the last
+    // course seen with a gram is known in both passes.
+    void Build(const CourseBST& bst) {
+        const int n = static_cast<int>(bst.Size());
+        gramStart.assign(GramCount + 1, 0);
+        shared.assign(n, 0);
+        vector<int> lastSeen(GramCount, -1); // also makes a gram repeated within one course count once
+
+        auto forEachCourseGram = [&](int id, auto visit) {
+            auto once = [&](uint32_t gram) {
+                if (lastSeen[gram] == id) return;
+                visit(gram, static_cast<uint32_t>(id - lastSeen[gram]));
+                lastSeen[gram] = id;
+            };
+            number.clear();
+            bst.Number(id).AppendTo(number);
+            ForEachGram(number, once);
+            ForEachGram(bst.Title(id), once);
+        };
+
+        for (int id = 0; id < n; ++id) {
+            forEachCourseGram(id, [&](uint32_t gram, uint32_t gap) { gramStart[gram + 1] += VarintBytes(gap); });
+        }
+        for (uint32_t g = 0; g < GramCount; ++g) gramStart[g + 1] += gramStart[g];
+
+        postings.clear();
+        postings.shrink_to_fit();
+        postings.resize(gramStart[GramCount]);
+        vector<size_t> fill(gramStart.begin(), gramStart.end() - 1);
+        fill_n(lastSeen.begin(), GramCount, -1);
+        for (int id = 0; id < n; ++id) {
+            forEachCourseGram(id, [&](uint32_t gram, uint32_t gap) {
+                size_t& at = fill[gram];
+                for (; gap >= 0x80; gap >>= 7) postings[at++] = static_cast<uint8_t>(gap | 0x80);
+                postings[at++] = static_cast<uint8_t>(gap);
+            });
+        }
+    }
+
+    // Up to limit courses closest to the query, best first. A course
+    // qualifies if its number, or some part of its title, is within roughly
+    // one edit per three query characters.
+    vector<int> Suggest(const CourseBST& bst, const string& query, size_t limit) const {
+        vector<int> out;
+        const string q = upperCopy(trimView(query));
+        if (q.empty() || shared.empty() || limit == 0) return out;
+
+        queryGrams.clear();
+        ForEachGram(q, [&](uint32_t gram) { queryGrams.push_back(gram); });
+        sort(queryGrams.begin(), queryGrams.end());
+        queryGrams.erase(unique(queryGrams.begin(), queryGrams.end()), queryGrams.end());
+        auto listSize = [&](uint32_t gram) { return gramStart[gram + 1] - gramStart[gram]; };
+        sort(queryGrams.begin(), queryGrams.end(),
+             [&](uint32_t a, uint32_t b) { return listSize(a) < listSize(b); });
+
+        // Count shared trigrams over the rarest lists. If even the rarest is
+        // over budget the query narrows nothing, and its first (lowest) ids
+        // stand in, which is what the tie break below would pick anyway.
+        touched.clear();
+        size_t budget = PostingBudget;
+        for (uint32_t gram : queryGrams) {
+            size_t k = gramStart[gram], end = gramStart[gram + 1];
+            if (k == end) continue;
+            if (end - k > budget) {
+                if (!touched.empty()) break;
+                end = k + budget;
+            }
+            budget -= end - k;
+            int id = -1;
+            while (k < end) {
+                uint32_t gap = 0;
+                for (int shift = 0;; shift += 7) {
+                    uint8_t byte = postings[k++];
+                    gap |= static_cast<uint32_t>(byte & 0x7F) << shift;
+                    if (byte < 0x80) break;
+                }
+                id += static_cast<int>(gap);
+                if (shared[id]++ == 0) touched.push_back(id);
+            }
+        }
+
+        // Only the strongest trigram matches are worth an edit distance.
+        // Counts are at most one per query gram, so a histogram finds the
+        // cut off in one pass and only the courses at or above it get sorted.
+        const size_t shortlist = min(touched.size(), max<size_t>(limit * 8, 32));
+        if (touched.size() > shortlist) {
+            histogram.assign(queryGrams.size() + 1, 0);
+            for (int id : touched) ++histogram[shared[id]];
+            size_t cut = queryGrams.size(), kept = histogram[cut];
+            while (kept < shortlist) kept += histogram[--cut];
+            auto weak = [&](int id) {
+                if (shared[id] >= cut) return false;
+                shared[id] = 0;
+                return true;
+            };
+            touched.erase(remove_if(touched.begin(), touched.end(), weak), touched.end());
+        }
+        auto moreShared = [&](int a, int b) {
+            return shared[a] != shared[b] ? shared[a] > shared[b] : a < b;
+        };
+        partial_sort(touched.begin(), touched.begin() + shortlist, touched.end(), moreShared);
+        for (int id : touched) shared[id] = 0;
+        touched.resize(shortlist);
+
+        const size_t maxDistance = (q.size() + 2) / 3;
+        ranked.clear();
+        for (int id : touched) {
+            number.clear();
+            bst.Number(id).AppendTo(number);
+            size_t d = min(EditDistance(q, number, prevRow, curRow),
+                           SubstringEditDistance(q, bst.Title(id), prevRow, curRow));
+            if (d <= maxDistance) ranked.emplace_back(d, id);
+        }
+        stable_sort(ranked.begin(), ranked.end(),
+                    [](const pair<size_t, int>& a, const pair<size_t, int>& b) { return a.first < b.first; });
+
+        for (size_t i = 0; i < ranked.size() && out.size() < limit; ++i) {
+            out.push_back(ranked[i].second);
+        }
+        return out;
+    }
+};
+
+// ----------------------------- Title Word Search -----------------------------
+
+// ASCII letters and digits: what isalnum means in the "C" locale, which the
+// program never leaves, but inline rather than a call per character.
+static inline bool isWordChar(char ch) {
+    unsigned char u = static_cast<unsigned char>(ch);
+    unsigned char lower = u | 0x20;
+    return (u >= '0' && u <= '9') || (lower >= 'a' && lower <= 'z');
+}
+
+// Calls visit(word) for each alphanumeric run of a title or query ("C++" ->
+// "C"). Words are views into text, case untouched.
+template <typename Visit>
+static void ForEachTitleWord(string_view text, Visit visit) {
+    size_t start = 0;
+    while (start < text.size()) {
+        while (start < text.size() && !isWordChar(text[start])) ++start;
+        size_t end = start;
+        while (end < text.size() && isWordChar(text[end])) ++end;
+        if (end > start) visit(text.substr(start, end - start));
+        start = end;
+    }
+}
+
+// Appends word lowercased. Words are all isWordChar, so setting the 0x20 bit
+// on letters is the whole of tolower.
+static void AppendLower(string& out, string_view word) {
+    size_t at = out.size();
+    out.append(word);
+    for (size_t i = at; i < out.size(); ++i) {
+        if (out[i] >= 'A' && out[i] <= 'Z') out[i] = static_cast<char>(out[i] | 0x20);
+    }
+}
+
+// Lowercase words of a query.
+static vector<string> TitleWords(string_view text) {
+    vector<string> words;
+    ForEachTitleWord(text, [&](string_view w) {
+        words.emplace_back();
+        AppendLower(words.back(), w);
+    });
+    return words;
+}
+
+// Inverted index from lowercase title words to the sorted ids of the courses
+// using them, in the same offset layout as CatalogGraph: word i is
+// wordPool[wordStart[i] .. wordStart[i + 1]) and its courses are
+// postings[postingStart[i] .. postingStart[i + 1]). The vocabulary is sorted
+// so a prefix is one contiguous range.
+class TitleIndex {
+private:
+    string wordPool;
+    vector<size_t> wordStart;
+    vector<size_t> postingStart;
+    vector<int> postings;
+
+    size_t VocabularySize() const { return wordStart.empty() ? 0 : wordStart.size() - 1; }
+
+    string_view Word(size_t i) const {
+        return string_view(wordPool.data() + wordStart[i], wordStart[i + 1] - wordStart[i]);
+    }
+
+    // Ids of courses with any title word starting with prefix.
+    vector<int> PrefixMatches(const string& prefix) const {
+        if (VocabularySize() == 0) return {};
+        size_t first = 0, count = VocabularySize();
+        while (count > 0) {
+            size_t half = count / 2;
+            if (Word(first + half) < prefix) {
+                first += half + 1;
+                count -= half + 1;
+            } else {
+                count = half;
+            }
+        }
+        size_t last = first;
+        while (last < VocabularySize() && Word(last).substr(0, prefix.size()) == prefix) ++last;
+
+        vector<int> ids(postings.begin() + postingStart[first], postings.begin() + postingStart[last]);
+        if (last - first > 1) {
+            sort(ids.begin(), ids.end());
+            ids.erase(unique(ids.begin(), ids.end()), ids.end());
+        }
+        return ids;
+    }
+
+public:
+    // Every title word is recorded as (course, offset, length) into the
+    // tree's own titles, with no string per word; sorting those by (word
+    // ignoring case, course) lines up each word's courses in order, and one
+    // pass emits the vocabulary and postings. Each occurrence also carries its
+    // first 16 bytes lowercased and packed big endian, so the sort compares
+    // integers and only reads the titles again for longer words that tie.
+    void Build(const CourseBST& bst) {
+        struct Occurrence {
+            uint32_t head[4];
+            int id;
+            uint32_t start; // within the title
+            uint32_t length;
+        };
+        auto lower = [](char ch) { return ch >= 'A' && ch <= 'Z' ? static_cast<char>(ch | 0x20) : ch; };
+        auto text = [&](const Occurrence& o) { return bst.Title(o.id).substr(o.start, o.length); };
+        // Heads are zero padded and words never hold a zero byte, so equal
+        // heads on two words of at most 16 bytes mean the same word.
+        auto compareWords = [&](const Occurrence& a, const Occurrence& b) {
+            for (int i = 0; i < 4; ++i) {
+                if (a.head[i] != b.head[i]) return a.head[i] < b.head[i] ? -1 : 1;
+            }
+            if (a.length <= 16 && b.length <= 16) return 0;
+            string_view x = text(a), y = text(b);
+            for (size_t i = 16; i < x.size() && i < y.size(); ++i) {
+                char p = lower(x[i]), q = lower(y[i]);
+                if (p != q) return p < q ? -1 : 1;
+            }
+            return x.size() == y.size() ? 0 : (x.size() < y.size() ? -1 : 1);
+        };
+
+        const int n = static_cast<int>(bst.Size());
+        size_t wordCount = 0;
+        for (int id = 0; id < n; ++id) ForEachTitleWord(bst.Title(id), [&](string_view) { ++wordCount; });
+        vector<Occurrence> occurrences;
+        occurrences.reserve(wordCount);
+        for (int id = 0; id < n; ++id) {
+            string_view title = bst.Title(id);
+            ForEachTitleWord(title, [&](string_view w) {
+                Occurrence o{{0, 0, 0, 0}, id, static_cast<uint32_t>(w.data() - title.data()),
+                             static_cast<uint32_t>(w.size())};
+                for (size_t i = 0; i < 16; ++i) {
+                    uint32_t byte = i < w.size() ? static_cast<unsigned char>(lower(w[i])) : 0;
+                    o.head[i / 4] = (o.head[i / 4] << 8) | byte;
+                }
+                occurrences.push_back(o);
+            });
+        }
+        sort(occurrences.begin(), occurrences.end(), [&](const Occurrence& a, const Occurrence& b) {
+            int c = compareWords(a, b);
+            return c != 0 ? c < 0 : a.id < b.id;
+        });
+
+        wordPool.clear();
+        wordStart.clear();
+        postingStart.clear();
+        postings.clear();
+        for (size_t i = 0; i < occurrences.size(); ++i) {
+            const Occurrence& o = occurrences[i];
+            if (i == 0 || compareWords(o, occurrences[i - 1]) != 0) {
+                wordStart.push_back(wordPool.size());
+                AppendLower(wordPool, text(o));
+                postingStart.push_back(postings.size());
+            } else if (o.id == occurrences[i - 1].id) {
+                continue; // word repeated within one title
+            }
+            postings.push_back(o.id);
+        }
+        wordStart.push_back(wordPool.size());
+        postingStart.push_back(postings.size());
+        wordPool.shrink_to_fit();
+    }
+
+    // Courses whose title has a word starting with every query word
+    // ("calc" finds Calculus I and II; "data struct" needs both), in course
+    // number order. Lists are intersected smallest first.
+    vector<int> Search(const string& query) const {
+        vector<int> out;
+        vector<string> words = TitleWords(query);
+        if (words.empty()) return out;
+
+        vector<vector<int>> lists;
+        for (const string& w : words) {
+            lists.push_back(PrefixMatches(w));
+            if (lists.back().empty()) return out;
+        }
+        sort(lists.begin(), lists.end(),
+             [](const vector<int>& a, const vector<int>& b) { return a.size() < b.size(); });
+
+        vector<int> result = lists[0], next;
+        for (size_t i = 1; i < lists.size() && !result.empty(); ++i) {
+            next.clear();
+            set_intersection(result.begin(), result.end(), lists[i].begin(), lists[i].end(), back_inserter(next));
+            swap(result, next);
+        }
+        return result;
+    }
+};
+
+// --------------------------- Loader / Validation -----------------------------
+
+// Parse one course file, handing each valid record to
+// sink.Emplace(number, title, prereqs). The sink is the BST itself for a
+// single file, or a CourseBatch when several files are parsed in parallel.
+// where starts each message ("Line 3" or "math.csv line 3"). Bytes and
+// lines read are added to stats.
+// False only if the file couldn't be read to the end.
+template <typename Sink>
+static bool ParseCourses(ByteSource& source, const string& filePath, const string& where, Sink& sink,
+                         vector<string>& errors, size_t& loadCount, LoadStats& stats) {
+    CsvReader reader(source);
+    vector<string_view> tokens;
+    CourseKey number;
+    vector<CourseKey> prereqs; // reused across lines so it's allocated once, not per course
+
+    // First pass: parse each record -> emplace the course straight into the sink
+    while (reader.Next(tokens)) {
+        // Message prefix, only built when there is something to report.
+        auto line = [&]() { return where + " " + to_string(reader.RecordLine()); };
+        if (tokens.size() == 1 && tokens[0].empty()) continue; // blank line
+
+        if (reader.Unterminated()) {
+            errors.push_back(line() + ": quoted field is missing its closing quote.");
+            continue;
+        }
+        if (tokens.size() < 2) {
+            errors.push_back(line() + ": needs at least Course Number and Title.");
+            continue;
+        }
 
-using namespace std;
+        string_view title = tokens[1];
+        prereqs.clear();
 
-// --------------------------- Utility helpers --------------------------------
+        if (tokens[0].empty()) {
+            errors.push_back(line() + ": missing course number.");
+            continue;
+        }
+        if (!CourseKey::FromString(tokens[0], number, true)) {
+            errors.push_back(line() + ": course number " + CourseKey::Rejection + ".");
+            continue;
+        }
+        if (title.empty()) {
+            errors.push_back(line() + ": missing course title.");
+            continue;
+        }
 
-// trim: remove leading/trailing whitespace
-static inline string trim(const string& s) {
-    size_t start = 0, end = s.size();
-    while (start < end && isspace(static_cast<unsigned char>(s[start]))) ++start;
-    while (end > start && isspace(static_cast<unsigned char>(s[end - 1]))) --end;
-    return s.substr(start, end - start);
+        // 0..N prerequisites
+        for (size_t i = 2; i < tokens.size(); ++i) {
+            if (tokens[i].empty()) continue;
+            CourseKey p;
+            if (!CourseKey::FromString(tokens[i], p, true)) {
+                errors.push_back(line() + ": prerequisite '" + string(tokens[i]) + "' " + CourseKey::Rejection + ".");
+                continue;
+            }
+            prereqs.push_back(p);
+        }
+
+        sink.Emplace(number, title, CourseBST::KeyRange{prereqs.data(), prereqs.data() + prereqs.size()});
+        ++loadCount;
+    }
+    stats.bytesParsed += reader.BytesRead();
+    stats.lines += reader.LinesRead();
+    if (!source.Error().empty()) {
+        // A truncated or corrupt file would leave a partial catalog, so the load fails.
+        errors.push_back("Error: reading '" + filePath + "' failed (" + source.Error() + ").");
+        return false;
+    }
+    return true;
 }
 
-// split a CSV line by ',' and trim each token (no quotes handling needed per project)
-static vector<string> splitCSV(const string& line) {
-    vector<string> out;
-    string token;
-    stringstream ss(line);
-    while (getline(ss, token, ',')) {
-        out.push_back(trim(token));
+// Everything after the last insert, shared by the single and multi file loaders.
+static void ValidateCatalog(CourseBST& bst, CatalogGraph& graph, vector<string>& errors) {
+    // Rows into sorted order so the passes below (and printing) stream the columns.
+    bst.Compact();
+
+    // Second pass: validate the prerequisite graph.
+    // (I’m not failing the load, just reporting issues so advisors are informed.)
+    // Walking the tree once, every prerequisite is resolved to a course id
+    // (missing ones are reported), then Tarjan's SCC finds every cycle such as
+    // A requires B, B requires A. Both steps are linear in courses + prereqs
+    // after the in order walk, and so is describing the cycles (one scratch
+    // array for all of them), so this stays cheap on large catalogs.
+    // The graph is handed back to main so the planner can reuse it.
+    BuildCatalogGraph(bst, graph, errors);
+    vector<int> parent(graph.Size(), -2);
+    for (const vector<int>& scc : FindPrerequisiteCycles(graph)) {
+        errors.push_back(DescribeCycle(bst, graph, scc, parent));
     }
-    // Handle trailing comma case (if any) we already read empty token above, which trim keeps as ""
-    return out;
 }
 
-// uppercase a course number so comparisons/user input are consistent
-static string upperCopy(string s) {
-    for (char& ch : s) ch = static_cast<char>(toupper(static_cast<unsigned char>(ch)));
-    return s;
+// Sink for ParseCourses that times each insert, so the load report can
+// separate tree work from parsing (two clock reads per course).
+struct TimedInsert {
+    CourseBST& bst;
+    Clock::duration spent{0};
+
+    void Emplace(const CourseKey& number, string_view title, CourseBST::KeyRange prereqs) {
+        Clock::time_point start = Clock::now();
+        bst.Emplace(number, title, prereqs);
+        spent += Clock::now() - start;
+    }
+};
+
+// I prompt for filename in main, but encapsulate the file processing here.
+static bool LoadCoursesFromFile(const string& filePath, CourseBST& bst, CatalogGraph& graph,
+                                vector<string>& errors, size_t& loadCount, LoadStats& stats) {
+    // gzip and zstd files are decompressed as they are parsed (see OpenInputSource).
+    Clock::time_point start = Clock::now();
+    string openError;
+    unique_ptr<ByteSource> source = OpenInputSource(filePath, openError);
+    stats.openMs += MillisecondsSince(start);
+    if (!source) {
+        errors.push_back(openError);
+        return false;
+    }
+
+    // I’m clearing the previous tree so “Load” can be run multiple times with different files.
+    bst.Clear();
+    errors.clear();
+    loadCount = 0;
+
+    start = Clock::now();
+    TimedInsert sink{bst};
+    bool ok = ParseCourses(*source, filePath, "Line", sink, errors, loadCount, stats);
+    stats.insertMs = chrono::duration<double, milli>(sink.spent).count();
+    stats.parseMs = MillisecondsSince(start) - stats.insertMs;
+    if (!ok) return false;
+
+    start = Clock::now();
+    ValidateCatalog(bst, graph, errors);
+    stats.validateMs = MillisecondsSince(start);
+    return true;
 }
 
-// ------------------------------ Data Model -----------------------------------
+// One file's parsed courses, held until the merge. Same pooled layout as
+// CourseBST, without the tree.
+struct CourseBatch {
+    vector<CourseKey> keys;
+    vector<uint32_t> titleStart, titleLength;
+    vector<char> titlePool;
+    vector<uint32_t> prereqStart, prereqCount;
+    vector<CourseKey> prereqKeys;
+    vector<string> errors;
+    size_t count = 0;
+    bool ok = false;
+    LoadStats stats;
 
-struct Course {
-    string number;                // example CSCI200
-    string title;                 // example Intro to Algorithms
-    vector<string> prerequisites; // example {"CSCI100","MATH101"}
+    void Emplace(const CourseKey& number, string_view title, CourseBST::KeyRange prereqs) {
+        keys.push_back(number);
+        titleStart.push_back(static_cast<uint32_t>(titlePool.size()));
+        titleLength.push_back(static_cast<uint32_t>(title.size()));
+        titlePool.insert(titlePool.end(), title.begin(), title.end());
+        prereqStart.push_back(static_cast<uint32_t>(prereqKeys.size()));
+        prereqCount.push_back(static_cast<uint32_t>(prereqs.size()));
+        prereqKeys.insert(prereqKeys.end(), prereqs.begin(), prereqs.end());
+    }
 };
 
-// ---------------------------- Binary Search Tree -----------------------------
+// Load several course files (one per department) as one catalog. Files are
+// parsed in parallel, then merged in the order given, so the result never
+// depends on thread timing. Duplicate rule, same as within one file: the
+// later definition wins. When the earlier one came from a different file
+// it's reported. Prerequisites are validated once, across all files.
+// Any file that can't be read fails the whole load.
+static bool LoadCourseFiles(const vector<string>& filePaths, CourseBST& bst, CatalogGraph& graph,
+                            vector<string>& errors, size_t& loadCount, LoadStats& stats) {
+    Clock::time_point start = Clock::now();
+    vector<CourseBatch> batches(filePaths.size());
+    atomic<size_t> nextFile(0);
 
-class CourseBST {
-private:
-    struct Node {
-        Course course;
-        Node* left;
-        Node* right;
-        Node(const Course& c) : course(c), left(nullptr), right(nullptr) {}
+    auto work = [&]() {
+        for (size_t f = nextFile++; f < filePaths.size(); f = nextFile++) {
+            CourseBatch& batch = batches[f];
+            string openError;
+            unique_ptr<ByteSource> source = OpenInputSource(filePaths[f], openError);
+            if (!source) {
+                batch.errors.push_back(openError);
+                continue;
+            }
+            const string where = filesystem::path(filePaths[f]).filename().string() + " line";
+            batch.ok = ParseCourses(*source, filePaths[f], where, batch, batch.errors, batch.count, batch.stats);
+        }
     };
 
-    Node* root = nullptr;
+    size_t threads = min<size_t>(filePaths.size(), max<size_t>(1, thread::hardware_concurrency()));
+    vector<thread> pool;
+    for (size_t t = 1; t < threads; ++t) pool.emplace_back(work);
+    work();
+    for (thread& t : pool) t.join();
+    stats.parseMs = MillisecondsSince(start);
 
-    // I’m using recursive helpers to keep public API tiny and readable.
-    void destroy(Node* n) {
-        if (!n) return;
-        destroy(n->left);
-        destroy(n->right);
-        delete n;
+    errors.clear();
+    bool ok = true;
+    for (CourseBatch& batch : batches) {
+        errors.insert(errors.end(), batch.errors.begin(), batch.errors.end());
+        ok = ok && batch.ok;
+        stats.bytesParsed += batch.stats.bytesParsed;
+        stats.lines += batch.stats.lines;
     }
+    if (!ok) return false;
 
-    void inOrder(Node* n) const {
-        if (!n) return;
-        inOrder(n->left);
-        cout << n->course.number << ", " << n->course.title << '\n';
-        inOrder(n->right);
+    start = Clock::now();
+    bst.Clear();
+    loadCount = 0;
+    vector<size_t> origin; // file index per row, to spot cross file replacements
+    for (size_t f = 0; f < batches.size(); ++f) {
+        const CourseBatch& batch = batches[f];
+        for (size_t i = 0; i < batch.keys.size(); ++i) {
+            const CourseKey& key = batch.keys[i];
+            int existing = bst.Search(key);
+            if (existing == CourseBST::NotFound) {
+                origin.push_back(f);
+            } else if (origin[existing] != f) {
+                errors.push_back("Course '" + key.str() + "' from '" + filePaths[f] +
+                                 "' replaces the one from '" + filePaths[origin[existing]] + "'.");
+                origin[existing] = f;
+            }
+            const CourseKey* prereqs = batch.prereqKeys.data() + batch.prereqStart[i];
+            bst.Emplace(key, string_view(batch.titlePool.data() + batch.titleStart[i], batch.titleLength[i]),
+                        CourseBST::KeyRange{prereqs, prereqs + batch.prereqCount[i]});
+        }
+        loadCount += batch.count;
     }
+    stats.insertMs = MillisecondsSince(start);
+
+    start = Clock::now();
+    ValidateCatalog(bst, graph, errors);
+    stats.validateMs = MillisecondsSince(start);
+    return true;
+}
 
-    Node* insert(Node* n, const Course& c) {
-        if (!n) return new Node(c);
-        if (c.number < n->course.number) {
-            n->left = insert(n->left, c);
-        } else if (c.number > n->course.number) {
-            n->right = insert(n->right, c);
+// '*' and '?' wildcards, for the file name part of a catalog path.
+static bool WildcardMatch(string_view pattern, string_view name) {
+    size_t p = 0, n = 0, starP = string_view::npos, starN = 0;
+    while (n < name.size()) {
+        if (p < pattern.size() && (pattern[p] == '?' || pattern[p] == name[n])) {
+            ++p;
+            ++n;
+        } else if (p < pattern.size() && pattern[p] == '*') {
+            starP = p++;
+            starN = n;
+        } else if (starP != string_view::npos) {
+            p = starP + 1;
+            n = ++starN;
         } else {
-            // If duplicate key appears, I’ll update the title and prereqs (safer than ignoring).
-            n->course = c;
+            return false;
         }
-        return n;
     }
+    while (p < pattern.size() && pattern[p] == '*') ++p;
+    return p == pattern.size();
+}
 
-    const Course* search(Node* n, const string& number) const {
-        Node* cur = n;
-        while (cur) {
-            if (number == cur->course.number) return &cur->course;
-            cur = (number < cur->course.number) ? cur->left : cur->right;
+// What the user typed at "Load Data": one file, a directory (every file in
+// it), a wildcard in the file name (courses/*.csv), or several of those
+// separated by ';'. Directory and wildcard matches are sorted by name so
+// the merge order is repeatable.
+static bool ExpandCatalogPaths(const string& spec, vector<string>& paths, vector<string>& errors) {
+    paths.clear();
+    size_t start = 0;
+    while (start <= spec.size()) {
+        size_t semi = spec.find(';', start);
+        if (semi == string::npos) semi = spec.size();
+        const string part(trimView(string_view(spec).substr(start, semi - start)));
+        start = semi + 1;
+        if (part.empty()) continue;
+
+        const filesystem::path path(part);
+        const string name = path.filename().string();
+        const bool wildcard = name.find_first_of("*?") != string::npos;
+        error_code ec;
+        if (!wildcard && !filesystem::is_directory(path, ec)) {
+            paths.push_back(part);
+            continue;
         }
-        return nullptr;
+
+        const filesystem::path dir = wildcard ? (path.has_parent_path() ? path.parent_path() : ".") : path;
+        vector<string> matches;
+        for (filesystem::directory_iterator it(dir, ec), last; !ec && it != last; it.increment(ec)) {
+            const string entry = it->path().filename().string();
+            if (!it->is_regular_file(ec) || entry.empty() || entry[0] == '.') continue;
+            if (wildcard && !WildcardMatch(name, entry)) continue;
+            matches.push_back(it->path().string());
+        }
+        if (matches.empty()) {
+            errors.push_back("Error: no course files match '" + part + "'.");
+            return false;
+        }
+        sort(matches.begin(), matches.end());
+        paths.insert(paths.end(), matches.begin(), matches.end());
+    }
+    if (paths.empty()) {
+        errors.push_back("Error: no course file given.");
+        return false;
     }
+    return true;
+}
 
+// ------------------------------- Course Cache --------------------------------
+
+// Fully formatted PrintCourse output for the most asked-for courses, so a
+// hot query (intro courses get most of the traffic) is one hash lookup and
+// one write: no tree walk, no prerequisite lookups, no formatting.
+// Eviction is CLOCK: every hit sets the entry's reference bit and the hand
+// clears bits until it finds an entry nobody asked for since its last pass,
+// which approximates LRU without moving anything on a hit.
+// Not thread safe; the menu and batch mode are single threaded.
+class CourseCache {
 public:
-    CourseBST() = default;
-    ~CourseBST() { destroy(root); }
+    static constexpr size_t DefaultCapacity = 256;
 
-    void Clear() {
-        destroy(root);
-        root = nullptr;
+private:
+    struct Entry {
+        CourseKey key;
+        string text;
+        bool referenced = false;
+    };
+
+    vector<Entry> ring;                                  // grows to capacity, then recycled
+    unordered_map<CourseKey, size_t, CourseKeyHash> slot; // key -> ring index
+    size_t capacity;
+    size_t hand = 0;
+    uint64_t hits = 0, misses = 0, evictions = 0;
+
+public:
+    explicit CourseCache(size_t entries = DefaultCapacity) : capacity(entries) {}
+
+    // 0 turns the cache off.
+    void SetCapacity(size_t entries) {
+        capacity = entries;
+        Clear();
     }
 
-    void Insert(const Course& c) { root = insert(root, c); }
-    const Course* Search(const string& number) const { return search(root, number); }
-    void PrintInOrder() const { inOrder(root); }
-    bool Empty() const { return root == nullptr; }
-};
+    // Drops every entry; LoadCatalog calls this so nothing from an old
+    // catalog is ever printed. The counters keep running.
+    void Clear() {
+        ring.clear();
+        slot.clear();
+        hand = 0;
+    }
 
-// --------------------------- Loader / Validation -----------------------------
+    // Cached text for key, or nullptr. Valid until the next Put or Clear.
+    const string* Find(const CourseKey& key) {
+        if (capacity == 0) return nullptr;
+        auto it = slot.find(key);
+        if (it == slot.end()) {
+            ++misses;
+            return nullptr;
+        }
+        ++hits;
+        Entry& e = ring[it->second];
+        e.referenced = true;
+        return &e.text;
+    }
 
-// I prompt for filename in main, but encapsulate the file processing here.
-static bool LoadCoursesFromFile(const string& filePath, CourseBST& bst, vector<string>& errors, size_t& loadCount) {
-    ifstream file(filePath);
-    if (!file.is_open()) {
-        errors.push_back("Error: cannot open file '" + filePath + "'.");
-        return false;
+    void Put(const CourseKey& key, string text) {
+        if (capacity == 0 || slot.count(key)) return;
+        if (ring.size() < capacity) {
+            slot.emplace(key, ring.size());
+            ring.push_back(Entry{key, move(text), false});
+            return;
+        }
+        while (ring[hand].referenced) {
+            ring[hand].referenced = false;
+            hand = (hand + 1) % ring.size();
+        }
+        Entry& victim = ring[hand];
+        slot.erase(victim.key);
+        victim.key = key;
+        victim.text = move(text);
+        slot.emplace(key, hand);
+        hand = (hand + 1) % ring.size();
+        ++evictions;
     }
 
-    // I’m clearing the previous tree so “Load” can be run multiple times with different files.
-    bst.Clear();
-    errors.clear();
-    loadCount = 0;
+    size_t Capacity() const { return capacity; }
+    size_t Size() const { return ring.size(); }
+    uint64_t Hits() const { return hits; }
+    uint64_t Misses() const { return misses; }
+    uint64_t Evictions() const { return evictions; }
+};
 
-    string rawLine;
-    size_t lineNumber = 0;
+// ---------------------------------- Catalog ----------------------------------
 
-    // First pass: parse each line -> build Course -> insert into BST
-    while (getline(file, rawLine)) {
-        ++lineNumber;
-        string line = trim(rawLine);
-        if (line.empty()) continue;
+// Everything built from one load. The graph, indexes and cache point into
+// the tree, so they are always rebuilt (or emptied) together. stats
+// describes the last load attempt.
+struct Catalog {
+    CourseBST bst;
+    CatalogGraph graph;
+    EligibilityEngine eligibility;
+    FuzzyIndex fuzzy;
+    TitleIndex titles;
+    CourseCache courseCache;
+    string listing;             // option 2 text, rendered on first use after a load
+    bool listingReady = false;
+    LoadStats stats;
+};
 
-        vector<string> tokens = splitCSV(line);
-        if (tokens.size() < 2) {
-            errors.push_back("Line " + to_string(lineNumber) + ": needs at least Course Number and Title.");
-            continue;
+// fileSpec is anything ExpandCatalogPaths accepts.
+[[maybe_unused]]
+static bool LoadCatalog(const string& fileSpec, Catalog& catalog, vector<string>& errors, size_t& loadCount) {
+    catalog.courseCache.Clear();
+    catalog.listing.clear();
+    catalog.listingReady = false;
+    LoadStats& stats = catalog.stats;
+    stats = LoadStats();
+    const AllocationCount allocatedBefore = CurrentAllocations();
+    const Clock::time_point loadStart = Clock::now();
+
+    auto finish = [&](bool ok) {
+        stats.ok = ok;
+        stats.records = loadCount;
+        stats.issues = errors.size();
+        if (ok) {
+            const CourseBST::TreeStats tree = catalog.bst.Stats();
+            stats.courses = tree.nodes;
+            stats.treeHeight = tree.height;
+            stats.averageDepth = tree.averageDepth;
         }
+        stats.totalMs = MillisecondsSince(loadStart);
+        const AllocationCount allocatedAfter = CurrentAllocations();
+        stats.allocated.allocations = allocatedAfter.allocations - allocatedBefore.allocations;
+        stats.allocated.bytes = allocatedAfter.bytes - allocatedBefore.bytes;
+        return ok;
+    };
 
-        Course c;
-        c.number = upperCopy(tokens[0]);
-        c.title  = tokens[1];
+    vector<string> paths;
+    Clock::time_point start = Clock::now();
+    if (!ExpandCatalogPaths(fileSpec, paths, errors)) return finish(false);
+    stats.files = paths.size();
+    for (const string& path : paths) {
+        error_code ec;
+        uintmax_t size = filesystem::file_size(path, ec);
+        if (!ec) stats.fileBytes += size;
+    }
+    stats.openMs = MillisecondsSince(start);
 
-        if (c.number.empty()) {
-            errors.push_back("Line " + to_string(lineNumber) + ": missing course number.");
-            continue;
-        }
-        if (c.title.empty()) {
-            errors.push_back("Line " + to_string(lineNumber) + ": missing course title.");
-            continue;
-        }
+    bool ok = paths.size() == 1
+        ? LoadCoursesFromFile(paths[0], catalog.bst, catalog.graph, errors, loadCount, stats)
+        : LoadCourseFiles(paths, catalog.bst, catalog.graph, errors, loadCount, stats);
+    if (!ok) return finish(false);
 
-        // 0..N prerequisites
-        for (size_t i = 2; i < tokens.size(); ++i) {
-            if (!tokens[i].empty())
-                c.prerequisites.push_back(upperCopy(tokens[i]));
-        }
+    start = Clock::now();
+    catalog.eligibility.Build(catalog.graph);
+    // Titles first: their word list is scratch, freed before the trigram postings exist.
+    catalog.titles.Build(catalog.bst);
+    catalog.fuzzy.Build(catalog.bst);
+    stats.indexMs = MillisecondsSince(start);
+    return finish(true);
+}
 
-        bst.Insert(c);
-        ++loadCount;
+// ------------------------------- Printing ------------------------------------
+
+static void PrintSuggestions(ostream& out, const CourseBST& bst, const vector<int>& suggestions) {
+    for (int id : suggestions) {
+        out << "  " << bst.Number(id) << " - " << bst.Title(id) << '\n';
     }
-    file.close();
+}
 
-    // Second pass: validate that every prerequisite appears as its own course number
-    // (I’m not failing the load, just reporting issues so advisors are informed.)
-    // This is O(p log n) on average with a BST.
-    // If there were format errors in pass 1, they’re already listed in errors.
-    // Here I traverse by printing into a vector via in order so I can re search.
-    // To keep it simple and memory light, I’ll just walk the tree by printing then re search.
-    // But we don’t have an exposed iterator, so instead, I’ll reopen file to check prereqs exist.
+[[maybe_unused]]
+static void PrintTitleSearch(const CourseBST& bst, const TitleIndex& titles, const string& query) {
+    vector<int> matches = titles.Search(query);
+    if (matches.empty()) {
+        cout << "No course titles match.\n";
+        return;
+    }
+    cout << "\nTitle Matches (" << matches.size() << "):\n";
+    PrintSuggestions(cout, bst, matches);
+}
 
+// A course number the user typed, looked up and recorded in queryMetrics.
+static int LookupCourse(const CourseBST& bst, string_view number, size_t& comparisons) {
+    Clock::time_point start = Clock::now();
+    size_t compared = 0;
+    int row = bst.Search(number, compared);
+    queryMetrics.search.Record(start, row != CourseBST::NotFound, compared);
+    comparisons += compared;
+    return row;
+}
 
-    ifstream file2(filePath);
-    lineNumber = 0;
-    while (getline(file2, rawLine)) {
-        ++lineNumber;
-        string line = trim(rawLine);
-        if (line.empty()) continue;
+static int LookupCourse(const CourseBST& bst, string_view number) {
+    size_t comparisons = 0;
+    return LookupCourse(bst, number, comparisons);
+}
 
-        vector<string> tokens = splitCSV(line);
-        if (tokens.size() < 2) continue; // already reported earlier
+// Writes the course (or "Course not found." and suggestions) to out and
+// returns its row, NotFound on a miss.
+static int PrintCourse(ostream& out, const CourseBST& bst, const FuzzyIndex& fuzzy, const string& queryNumber) {
+    Clock::time_point start = Clock::now();
+    size_t comparisons = 0;
+    int row = LookupCourse(bst, trimView(queryNumber), comparisons);
+    if (row == CourseBST::NotFound) {
+        out << "Course not found.\n";
+        // Typos like CSC1300 or a partial title still get the advisor somewhere.
+        vector<int> suggestions = fuzzy.Suggest(bst, queryNumber, 5);
+        if (!suggestions.empty()) {
+            out << "Did you mean:\n";
+            PrintSuggestions(out, bst, suggestions);
+        }
+        queryMetrics.course.Record(start, false, comparisons);
+        return row;
+    }
 
-        string courseNum = upperCopy(tokens[0]);
+    out << bst.Number(row) << " - " << bst.Title(row) << '\n';
 
-        for (size_t i = 2; i < tokens.size(); ++i) {
-            string p = upperCopy(tokens[i]);
-            if (p.empty()) continue;
-            if (bst.Search(p) == nullptr) {
-                errors.push_back("Course '" + courseNum + "' lists missing prerequisite '" + p + "'.");
+    CourseBST::KeyRange prereqs = bst.Prerequisites(row);
+    if (prereqs.empty()) {
+        out << "Prerequisites: None\n";
+    } else {
+        out << "Prerequisites:\n";
+        for (const CourseKey& p : prereqs) {
+            int pr = bst.Search(p, comparisons);
+            if (pr != CourseBST::NotFound) {
+                out << "  " << bst.Number(pr) << " - " << bst.Title(pr) << '\n';
+            } else {
+                // If a prerequisite didn’t exist, I still show the code so the advisor knows.
+                out << "  " << p << " (missing from catalog)\n";
             }
         }
     }
-    file2.close();
+    queryMetrics.course.Record(start, true, comparisons);
+    return row;
+}
 
-    return true;
+// Option 3 and batch "course": PrintCourse behind the hot course cache.
+// Only found courses are cached; misses depend on the fuzzy suggestions
+// and are rare enough to format every time.
+[[maybe_unused]]
+static void PrintCourse(Catalog& catalog, const string& queryNumber) {
+    CourseKey key;
+    const bool validKey = CourseKey::FromString(trimView(queryNumber), key, true);
+    if (validKey) {
+        Clock::time_point start = Clock::now();
+        if (const string* text = catalog.courseCache.Find(key)) {
+            // The cache stands in for the tree search, so it counts as a
+            // found search with no nodes compared.
+            queryMetrics.search.Record(start, true, 0);
+            cout << *text;
+            queryMetrics.course.Record(start, true, 0);
+            return;
+        }
+    }
+    if (!validKey || catalog.courseCache.Capacity() == 0) {
+        PrintCourse(cout, catalog.bst, catalog.fuzzy, queryNumber);
+        return;
+    }
+    ostringstream text;
+    if (PrintCourse(text, catalog.bst, catalog.fuzzy, queryNumber) != CourseBST::NotFound) {
+        catalog.courseCache.Put(key, text.str());
+    }
+    cout << text.str();
 }
 
-// ------------------------------- Printing ------------------------------------
+// Option 2 and batch "list". The catalog only changes on a load, so the
+// listing is rendered once into one buffer and every later request is a
+// single write.
+[[maybe_unused]]
+static void PrintCourseList(Catalog& catalog) {
+    Clock::time_point start = Clock::now();
+    if (!catalog.listingReady) {
+        catalog.bst.RenderInOrder(catalog.listing);
+        catalog.listingReady = true;
+    }
+    cout.write(catalog.listing.data(), static_cast<streamsize>(catalog.listing.size()));
+    queryMetrics.list.Record(start, !catalog.bst.Empty(), 0);
+}
 
-static void PrintCourse(const CourseBST& bst, const string& queryNumber) {
-    string key = upperCopy(queryNumber);
-    const Course* c = bst.Search(key);
-    if (!c) {
-        cout << "Course not found.\n";
+// targetList is a comma separated list of course numbers as typed by the user.
+[[maybe_unused]]
+static void PrintSemesterPlan(const CourseBST& bst, const CatalogGraph& graph, const string& targetList,
+                              size_t perTerm) {
+    vector<int> targets;
+    vector<string_view> tokens;
+    splitCSV(targetList, tokens);
+    for (string_view token : tokens) {
+        if (token.empty()) continue;
+        int id = LookupCourse(bst, token);
+        if (id == CourseBST::NotFound) {
+            cout << "Course '" << upperCopy(token) << "' not found, skipping.\n";
+            continue;
+        }
+        targets.push_back(id);
+    }
+    if (targets.empty()) {
+        cout << "No valid target courses to plan.\n";
         return;
     }
 
-    cout << c->number << " - " << c->title << '\n';
+    SemesterPlan plan = PlanSemesters(graph, targets, perTerm);
 
-    if (c->prerequisites.empty()) {
-        cout << "Prerequisites: None\n";
-        return;
+    cout << "\nSemester Plan (max " << perTerm << " per term):\n";
+    for (size_t t = 0; t < plan.terms.size(); ++t) {
+        cout << "  Term " << (t + 1) << ": ";
+        for (size_t i = 0; i < plan.terms[t].size(); ++i) {
+            if (i) cout << ", ";
+            cout << bst.Number(plan.terms[t][i]);
+        }
+        cout << '\n';
     }
+    if (!plan.unschedulable.empty()) {
+        cout << "Cannot schedule (prerequisite cycle or missing prerequisite):";
+        for (int v : plan.unschedulable) cout << ' ' << bst.Number(v);
+        cout << '\n';
+    }
+}
 
-    cout << "Prerequisites:\n";
-    for (const string& p : c->prerequisites) {
-        const Course* pc = bst.Search(p);
-        if (pc) {
-            cout << "  " << pc->number << " - " << pc->title << '\n';
-        } else {
-            // If a prerequisite didn’t exist, I still show the code so the advisor knows.
-            cout << "  " << p << " (missing from catalog)\n";
+// completedList is a comma separated list of course numbers as typed by the user.
+[[maybe_unused]]
+static void PrintEligibleCourses(const CourseBST& bst, const EligibilityEngine& engine,
+                                 const string& completedList) {
+    vector<int> completed;
+    vector<string_view> tokens;
+    splitCSV(completedList, tokens);
+    for (string_view token : tokens) {
+        if (token.empty()) continue;
+        int id = LookupCourse(bst, token);
+        if (id == CourseBST::NotFound) {
+            cout << "Course '" << upperCopy(token) << "' not found, skipping.\n";
+            continue;
         }
+        completed.push_back(id);
     }
+
+    vector<int> eligible;
+    engine.Eligible(engine.MakeCompleted(completed), eligible);
+
+    if (eligible.empty()) {
+        cout << "No courses are currently eligible.\n";
+        return;
+    }
+    cout << "\nEligible Courses (" << eligible.size() << "):\n";
+    for (int id : eligible) {
+        cout << "  " << bst.Number(id) << " - " << bst.Title(id) << '\n';
+    }
+}
+
+[[maybe_unused]]
+static void PrintTreeStats(ostream& out, const CourseBST::TreeStats& st) {
+    const double KB = 1024.0;
+    out << fixed << setprecision(1)
+        << "\nTree Statistics:\n"
+        << "  Index: " << st.index << ", up to " << st.fanout << " children per node\n"
+        << "  Courses: " << st.nodes << " (" << st.leaves << " leaves)\n"
+        << "  Height: " << st.height << " (balanced would be " << st.minimalHeight << ")\n"
+        << "  Average search depth: " << st.averageDepth << ", worst: " << st.height << '\n'
+        << "  Memory, KB used (reserved):\n"
+        << "    keys           " << setw(10) << st.keyBytes / KB << " (" << st.keyCapacity / KB << ")\n"
+        << "    titles         " << setw(10) << st.titleBytes / KB << " (" << st.titleCapacity / KB << ")\n"
+        << "    prerequisites  " << setw(10) << st.prereqBytes / KB << " (" << st.prereqCapacity / KB << ")\n"
+        << "    tree nodes     " << setw(10) << st.linkBytes / KB << " (" << st.linkCapacity / KB << ")\n"
+        << "    total          " << setw(10) << st.TotalBytes() / KB << " (" << st.TotalCapacity() / KB << ")\n";
+    if (st.deadTitleBytes + st.deadPrereqBytes > 0) {
+        out << "  Replaced entries still pooled: " << (st.deadTitleBytes + st.deadPrereqBytes) / KB << " KB\n";
+    }
+    if (st.Degenerate()) {
+        out << "  Warning: the tree is far taller than a balanced one; lookups walk\n"
+            << "  " << st.averageDepth << " nodes on average instead of about " << st.minimalHeight << ".\n";
+    }
+    out << defaultfloat << setprecision(6);
 }
 
+// Everything from here down is the program itself: the menu, batch mode and
+// main. Benchmarks.cpp and CsvCheck.cpp include this file to reach the
+// internals, define ABCU_NO_MAIN and bring their own main.
+#ifndef ABCU_NO_MAIN
+
 // ------------------------------- Menu UI -------------------------------------
 
 static void PrintMenu() {
@@ -250,17 +3373,136 @@ static void PrintMenu() {
     cout << "  1. Load Data\n";
     cout << "  2. Print Course List (Sorted)\n";
     cout << "  3. Print Course\n";
+    cout << "  4. Plan Semesters\n";
+    cout << "  5. Check Eligibility\n";
+    cout << "  6. Cohort Eligibility (student file)\n";
+    cout << "  7. Find Course (fuzzy number or title)\n";
+    cout << "  8. Search Course Titles\n";
+    cout << " 10. Load Report (timing of the last load)\n";
+    cout << " 11. Tree Statistics (shape and memory)\n";
+    cout << " 12. Query Metrics (lookup latency and counts)\n";
     cout << "  9. Exit\n";
     cout << "Enter choice: ";
 }
 
+// --------------------------------- Batch -----------------------------------
+
+static void PrintUsage() {
+    cerr << "Usage: ProjectTwo [--course-cache=N]       (interactive menu, N hot courses cached)\n"
+         << "       ProjectTwo <courses.csv> list\n"
+         << "       ProjectTwo <courses.csv> course <number>\n"
+         << "       ProjectTwo <courses.csv> search <words...>\n"
+         << "  <courses.csv> may also be a folder, a wildcard, or several paths separated by ';'.\n"
+         << "  --load-stats[=FILE] anywhere writes the load report as JSON to FILE (default stderr).\n"
+         << "  --query-stats[=FILE] does the same for query latency and counts, after the command.\n";
+}
+
+// Removes "--name" or "--name=VALUE" from args. True if it was there.
+static bool TakeFlag(vector<string>& args, const string& name, string& path) {
+    bool found = false;
+    for (size_t i = 0; i < args.size();) {
+        if (args[i] == name || args[i].compare(0, name.size() + 1, name + "=") == 0) {
+            found = true;
+            path = args[i].size() > name.size() ? args[i].substr(name.size() + 1) : "";
+            args.erase(args.begin() + i);
+        } else {
+            ++i;
+        }
+    }
+    return found;
+}
+
+// A JSON report to path, or stderr when path is empty.
+template <typename Writer>
+static void WriteReport(const string& path, Writer write) {
+    if (path.empty()) {
+        write(cerr);
+        return;
+    }
+    ofstream file(path);
+    write(file);
+    if (!file) cerr << "Error: cannot write file '" << path << "'.\n";
+}
+
+// One load, one command, results on stdout and validation issues on stderr,
+// so scripts can pipe the output. Returns the process exit code.
+static int RunBatch(vector<string> args) {
+    string loadStatsPath, queryStatsPath;
+    const bool wantLoadStats = TakeFlag(args, "--load-stats", loadStatsPath);
+    const bool wantQueryStats = TakeFlag(args, "--query-stats", queryStatsPath);
+    if (args.size() < 2) {
+        PrintUsage();
+        return 2;
+    }
+    const string& command = args[1];
+    string rest;
+    for (size_t i = 2; i < args.size(); ++i) rest += (i > 2 ? " " : "") + args[i];
+
+    if ((command == "course" || command == "search") && trim(rest).empty()) {
+        PrintUsage();
+        return 2;
+    }
+    if (command != "list" && command != "course" && command != "search") {
+        cerr << "Unknown command '" << command << "'.\n";
+        PrintUsage();
+        return 2;
+    }
+
+    Catalog catalog;
+    vector<string> errors;
+    size_t count = 0;
+    bool ok = LoadCatalog(args[0], catalog, errors, count);
+    for (const string& e : errors) cerr << e << '\n';
+    if (wantLoadStats) {
+        WriteReport(loadStatsPath, [&](ostream& out) { WriteLoadStatsJson(out, catalog.stats); });
+    }
+    if (!ok) return 1;
+
+    if (command == "list") {
+        PrintCourseList(catalog);
+    } else if (command == "course") {
+        PrintCourse(catalog, trim(rest));
+    } else {
+        for (int id : catalog.titles.Search(rest)) {
+            cout << catalog.bst.Number(id) << ", " << catalog.bst.Title(id) << '\n';
+        }
+    }
+    if (wantQueryStats) {
+        cout.flush();
+        WriteReport(queryStatsPath, [](ostream& out) { WriteQueryMetricsJson(out, queryMetrics); });
+    }
+    return 0;
+}
+
 // --------------------------------- main --------------------------------------
 
-int main() {
+int main(int argc, char* argv[]) {
     ios::sync_with_stdio(false);
     cin.tie(nullptr);
 
-    CourseBST bst;
+    vector<string> args(argv + 1, argv + argc);
+    string cacheSize;
+    const bool cacheFlag = TakeFlag(args, "--course-cache", cacheSize);
+    if (!args.empty()) {
+        // A batch run looks up at most one course, so there is nothing to cache.
+        if (cacheFlag) {
+            cerr << "--course-cache only applies to the interactive menu.\n";
+            PrintUsage();
+            return 2;
+        }
+        return RunBatch(args);
+    }
+
+    Catalog catalog;
+    if (cacheFlag) {
+        try {
+            catalog.courseCache.SetCapacity(stoul(cacheSize));
+        } catch (const exception&) {
+            cout << "Ignoring --course-cache='" << cacheSize << "' (expected a number, 0 turns it off).\n";
+        }
+    }
+    const CourseBST& bst = catalog.bst;
+    const CatalogGraph& graph = catalog.graph;
     bool dataLoaded = false;
     string loadedFile;
     size_t loadedCount = 0;
@@ -271,7 +3513,7 @@ int main() {
         if (!getline(cin, choice)) break; // EOF/stream closed
 
         if (choice == "1") {
-            cout << "Enter the course data filename (e.g., courses.txt): ";
+            cout << "Enter the course data filename (e.g., courses.txt, a folder, dept/*.csv, or a;b): ";
             string filePath;
             if (!getline(cin, filePath)) {
                 cout << "Input aborted.\n";
@@ -281,7 +3523,7 @@ int main() {
 
             vector<string> errors;
             size_t count = 0;
-            bool ok = LoadCoursesFromFile(filePath, bst, errors, count);
+            bool ok = LoadCatalog(filePath, catalog, errors, count);
 
             if (!ok) {
                 cout << "Load failed.\n";
@@ -292,6 +3534,8 @@ int main() {
             } else if (ok) {
                 cout << "File validated. Loaded " << count << " courses.\n";
             }
+            cout << "Load took " << fixed << setprecision(1) << catalog.stats.totalMs << defaultfloat
+                 << " ms (Option 10 shows the breakdown).\n";
 
             dataLoaded = ok;
             loadedFile = filePath;
@@ -303,7 +3547,7 @@ int main() {
                 continue;
             }
             cout << "\nCourse List (alphanumeric):\n";
-            bst.PrintInOrder();
+            PrintCourseList(catalog);
 
         } else if (choice == "3") {
             if (!dataLoaded || bst.Empty()) {
@@ -321,7 +3565,149 @@ int main() {
                 cout << "Please enter a non-empty course number.\n";
                 continue;
             }
-            PrintCourse(bst, target);
+            PrintCourse(catalog, target);
+
+        } else if (choice == "4") {
+            if (!dataLoaded || bst.Empty()) {
+                cout << "Please load data first (Option 1).\n";
+                continue;
+            }
+            cout << "Enter target course numbers, comma separated (e.g., CSCI400,CSCI350): ";
+            string targets;
+            if (!getline(cin, targets)) {
+                cout << "Input aborted.\n";
+                continue;
+            }
+            cout << "Enter the maximum number of courses per term: ";
+            string limitText;
+            if (!getline(cin, limitText)) {
+                cout << "Input aborted.\n";
+                continue;
+            }
+            size_t perTerm = 0;
+            try {
+                perTerm = stoul(trim(limitText));
+            } catch (const exception&) {
+                perTerm = 0;
+            }
+            if (perTerm == 0) {
+                cout << "Please enter a positive number of courses per term.\n";
+                continue;
+            }
+            PrintSemesterPlan(bst, graph, targets, perTerm);
+
+        } else if (choice == "5") {
+            if (!dataLoaded || bst.Empty()) {
+                cout << "Please load data first (Option 1).\n";
+                continue;
+            }
+            cout << "Enter completed course numbers, comma separated (blank for none): ";
+            string completed;
+            if (!getline(cin, completed)) {
+                cout << "Input aborted.\n";
+                continue;
+            }
+            PrintEligibleCourses(bst, catalog.eligibility, completed);
+
+        } else if (choice == "6") {
+            if (!dataLoaded || bst.Empty()) {
+                cout << "Please load data first (Option 1).\n";
+                continue;
+            }
+            cout << "Enter the student filename (StudentID,COURSE,COURSE,...): ";
+            string studentPath;
+            if (!getline(cin, studentPath)) {
+                cout << "Input aborted.\n";
+                continue;
+            }
+            cout << "Enter an output filename (blank to print here): ";
+            string outPath;
+            if (!getline(cin, outPath)) {
+                cout << "Input aborted.\n";
+                continue;
+            }
+            studentPath = trim(studentPath);
+            outPath = trim(outPath);
+
+            vector<StudentRecord> students;
+            vector<string> errors;
+            bool ok = LoadStudentsFromFile(studentPath, bst, students, errors);
+            if (!errors.empty()) {
+                cout << "\nStudent file issues (" << errors.size() << "):\n";
+                for (const string& e : errors) cout << " - " << e << '\n';
+            }
+            if (!ok) {
+                cout << "Cohort load failed.\n";
+                continue;
+            }
+
+            vector<vector<int>> results = EvaluateCohort(catalog.eligibility, students);
+            if (outPath.empty()) {
+                cout << "\nNewly Eligible Courses by Student:\n";
+                WriteCohortResults(cout, bst, students, results);
+            } else {
+                ofstream out(outPath);
+                if (!out.is_open()) {
+                    cout << "Error: cannot write file '" << outPath << "'.\n";
+                    continue;
+                }
+                WriteCohortResults(out, bst, students, results);
+                cout << "Wrote eligibility for " << students.size() << " students to '" << outPath << "'.\n";
+            }
+
+        } else if (choice == "7") {
+            if (!dataLoaded || bst.Empty()) {
+                cout << "Please load data first (Option 1).\n";
+                continue;
+            }
+            cout << "Enter part of a course number or title: ";
+            string query;
+            if (!getline(cin, query)) {
+                cout << "Input aborted.\n";
+                continue;
+            }
+            vector<int> suggestions = catalog.fuzzy.Suggest(bst, query, 10);
+            if (suggestions.empty()) {
+                cout << "No close matches.\n";
+                continue;
+            }
+            cout << "\nClosest Matches:\n";
+            PrintSuggestions(cout, bst, suggestions);
+
+        } else if (choice == "8") {
+            if (!dataLoaded || bst.Empty()) {
+                cout << "Please load data first (Option 1).\n";
+                continue;
+            }
+            cout << "Enter title words (e.g., data struct): ";
+            string query;
+            if (!getline(cin, query)) {
+                cout << "Input aborted.\n";
+                continue;
+            }
+            PrintTitleSearch(bst, catalog.titles, query);
+
+        } else if (choice == "10") {
+            // Shown for failed loads too, that's when it's most useful.
+            if (catalog.stats.files == 0 && !dataLoaded) {
+                cout << "Nothing loaded yet (Option 1).\n";
+                continue;
+            }
+            PrintLoadStats(cout, catalog.stats);
+
+        } else if (choice == "11") {
+            if (!dataLoaded || bst.Empty()) {
+                cout << "Please load data first (Option 1).\n";
+                continue;
+            }
+            PrintTreeStats(cout, bst.Stats());
+
+        } else if (choice == "12") {
+            PrintQueryMetrics(cout, queryMetrics);
+            const CourseCache& cache = catalog.courseCache;
+            cout << "  Course cache: " << cache.Size() << " of " << cache.Capacity() << " entries, "
+                 << cache.Hits() << " hits, " << cache.Misses() << " misses, "
+                 << cache.Evictions() << " evictions\n";
 
         } else if (choice == "9") {
             cout << "Goodbye.\n";
@@ -329,9 +3715,10 @@ int main() {
 
         } else {
             // Industry standard best practice: handle invalid menu input
-            cout << "Invalid choice. Please select 1, 2, 3, or 9.\n";
+            cout << "Invalid choice. Please select 1-8, 10-12 or 9.\n";
         }
     }
 
     return 0;
-}
\ No newline at end of file
+}
+#endif // ABCU_NO_MAIN
\ No newline at end of file
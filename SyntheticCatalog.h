@@ -0,0 +1,203 @@
+//============================================================================
+// Name        : SyntheticCatalog.h
+// Course      : CS 300 - DSA Design and Analysis
+// Description : Synthetic course catalog generator shared by
+//               GenerateCatalog.cpp (the command line tool) and
+//               Benchmarks.cpp. Emits lines in the exact format
+//               LoadCoursesFromFile accepts:
+//                 NUMBER,Title[,PREREQ...]
+// Notes       : -Course i is numbered from a 4 letter department and a 3
+//                digit number (AAAA100, AAAA101, ... AAAA999, AAAB100, ...),
+//                so millions of courses still look like real course numbers.
+//                longKeys pads every number to the full 16 bytes with a
+//                shared prefix, which is the worst case for key compares.
+//               -Prerequisites only point at lower numbered courses, so the
+//                catalog is acyclic unless errors are injected.
+//               -Same options and seed always give the same file.
+//============================================================================
+
+#ifndef ABCU_SYNTHETIC_CATALOG_H
+#define ABCU_SYNTHETIC_CATALOG_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <ostream>
+#include <random>
+#include <string>
+#include <vector>
+
+enum class KeyOrder { Sorted, Random, ZigZag };
+
+struct GeneratorOptions {
+    size_t courses = 1000;
+    uint64_t seed = 1;
+
+    // Row order. Random uses sortedness: 1 = sorted, 0 = fully shuffled,
+    // in between = sorted with that share of rows left in place.
+    // ZigZag writes lowest, highest, next lowest, ... (the worst case for
+    // an unbalanced BST, from both ends).
+    KeyOrder order = KeyOrder::Random;
+    double sortedness = 0.0;
+    bool longKeys = false;
+
+    // Fan-out: prerequisites per course are geometric with this mean,
+    // capped at maxPrereqs. Fan-in: prereqSkew > 1 piles references onto
+    // the lowest numbered (intro) courses, 1 = uniform.
+    double meanPrereqs = 1.5;
+    size_t maxPrereqs = 6;
+    double prereqSkew = 2.0;
+
+    // Title length in words, uniform in [minTitleWords, maxTitleWords].
+    // quotedRate is the share of titles with a comma, written RFC 4180 quoted.
+    size_t minTitleWords = 2;
+    size_t maxTitleWords = 6;
+    double quotedRate = 0.0;
+
+    // Error injection, each a per row probability.
+    double duplicateRate = 0.0; // repeat an earlier course number
+    double missingRate = 0.0;   // prerequisite that isn't in the catalog
+    double malformedRate = 0.0; // line the loader must skip
+};
+
+struct GeneratorStats {
+    size_t lines = 0;
+    size_t courses = 0;
+    size_t prerequisites = 0;
+    size_t duplicates = 0;
+    size_t missing = 0;
+    size_t malformed = 0;
+};
+
+// Course number for course index i. Indices at or past options.courses are
+// valid numbers that never appear in the file, which is how missing
+// prerequisites and search misses are made.
+inline std::string SyntheticCourseNumber(size_t i, const GeneratorOptions& options) {
+    size_t dept = i / 900;
+    char number[32];
+    char letters[5] = {
+        static_cast<char>('A' + (dept / (26 * 26 * 26)) % 26),
+        static_cast<char>('A' + (dept / (26 * 26)) % 26),
+        static_cast<char>('A' + (dept / 26) % 26),
+        static_cast<char>('A' + dept % 26),
+        '\0'
+    };
+    if (options.longKeys) {
+        std::snprintf(number, sizeof number, "COMPSCI%s%05zu", letters, i % 100000);
+    } else {
+        std::snprintf(number, sizeof number, "%s%03zu", letters, 100 + i % 900);
+    }
+    return number;
+}
+
+namespace synthetic_detail {
+
+static const char* const Vocabulary[] = {
+    "Introduction", "to", "Programming", "Data", "Structures", "Algorithms",
+    "Advanced", "Systems", "Computer", "Networks", "Operating", "Theory",
+    "Software", "Engineering", "Design", "Analysis", "Discrete", "Mathematics",
+    "Databases", "Security", "Machine", "Learning", "Graphics", "Compilers",
+    "Architecture", "Distributed", "Parallel", "Computing", "Web", "Development",
+    "Artificial", "Intelligence", "Human", "Interaction", "Numerical", "Methods",
+    "Topics", "Seminar", "Capstone", "Project", "Applied", "Foundations"
+};
+static const size_t VocabularySize = sizeof(Vocabulary) / sizeof(Vocabulary[0]);
+
+} // namespace synthetic_detail
+
+// Writes the catalog to out and returns what went into it.
+inline GeneratorStats WriteSyntheticCatalog(std::ostream& out, const GeneratorOptions& options) {
+    GeneratorStats stats;
+    const size_t n = options.courses;
+    std::mt19937_64 rng(options.seed);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+
+    // Row order
+    std::vector<size_t> ids(n);
+    for (size_t i = 0; i < n; ++i) ids[i] = i;
+    if (options.order == KeyOrder::ZigZag) {
+        for (size_t i = 0; i < n; ++i) ids[i] = (i % 2 == 0) ? i / 2 : n - 1 - i / 2;
+    } else if (options.order == KeyOrder::Random && options.sortedness < 1.0) {
+        // Shuffle only the rows not kept in place (Fisher-Yates over the picked positions).
+        std::vector<size_t> moved;
+        for (size_t i = 0; i < n; ++i) {
+            if (unit(rng) >= options.sortedness) moved.push_back(i);
+        }
+        for (size_t k = moved.size(); k > 1; --k) {
+            size_t j = rng() % k;
+            std::swap(ids[moved[k - 1]], ids[moved[j]]);
+        }
+    }
+
+    const double keepGoing = options.meanPrereqs / (1.0 + options.meanPrereqs);
+    std::string line;
+    std::vector<size_t> chosen;
+    for (size_t r = 0; r < n; ++r) {
+        size_t id = ids[r];
+        line.clear();
+
+        if (unit(rng) < options.malformedRate) {
+            // Alternate between a row with no title and a number that's too long.
+            if (stats.malformed % 2 == 0) line = SyntheticCourseNumber(id, options);
+            else line = "MALFORMEDCOURSENUMBER,Bad Row";
+            out << line << '\n';
+            ++stats.malformed;
+            ++stats.lines;
+            continue;
+        }
+
+        bool duplicate = r > 0 && unit(rng) < options.duplicateRate;
+        if (duplicate) {
+            id = ids[rng() % r];
+            ++stats.duplicates;
+        } else {
+            ++stats.courses;
+        }
+        line += SyntheticCourseNumber(id, options);
+        line += ',';
+
+        size_t words = options.minTitleWords;
+        if (options.maxTitleWords > words) words += rng() % (options.maxTitleWords - words + 1);
+        bool quoted = unit(rng) < options.quotedRate;
+        if (quoted) line += '"';
+        for (size_t w = 0; w < words; ++w) {
+            if (w) line += ' ';
+            line += synthetic_detail::Vocabulary[rng() % synthetic_detail::VocabularySize];
+            if (quoted && w == 0 && words > 1) line += ',';
+        }
+        if (!duplicate) {
+            line += ' ';
+            line += std::to_string(id);
+        }
+        if (quoted) line += '"';
+
+        size_t prereqs = 0;
+        while (prereqs < options.maxPrereqs && unit(rng) < keepGoing) ++prereqs;
+        if (id == 0) prereqs = 0;
+        chosen.clear();
+        for (size_t p = 0; p < prereqs; ++p) {
+            size_t target;
+            bool missing = unit(rng) < options.missingRate;
+            if (missing) {
+                target = n + rng() % (n + 1);
+            } else {
+                target = static_cast<size_t>(id * std::pow(unit(rng), options.prereqSkew));
+                if (target >= id) target = id - 1;
+            }
+            // Skewed picks repeat a lot; a course lists each prerequisite once.
+            if (std::find(chosen.begin(), chosen.end(), target) != chosen.end()) continue;
+            chosen.push_back(target);
+            if (missing) ++stats.missing;
+            line += ',';
+            line += SyntheticCourseNumber(target, options);
+            ++stats.prerequisites;
+        }
+
+        out << line << '\n';
+        ++stats.lines;
+    }
+    return stats;
+}
+
+#endif // ABCU_SYNTHETIC_CATALOG_H